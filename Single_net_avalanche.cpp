@@ -0,0 +1,223 @@
+/*-------------------------------------------------------------------------------
+ * Avalanche statistics of k-core percolation on single network
+ * For every percolation probability, removes every node of the pruned network one at
+ * a time, measures the avalanche it causes and undoes it
+ * Writes the mean avalanche size and depth, and the distribution of avalanche sizes
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+using namespace std;
+#include <iostream>
+
+#include <fstream>
+#include <set>
+
+#include <string>
+#include <sstream>
+
+
+// Random number generator
+#include "./statool/srand.hpp"
+
+
+// Node and graph data structures
+#include "node.hpp"
+#include "graph.hpp"
+
+
+// Network building algorithm file
+#include "net_algo.hpp"
+
+
+// Percolation process functions on the flat snapshot of the network
+#include "net_ops_flat.hpp"
+
+
+// Attack and prune kernels specialized for the thresholds of the network
+#include "net_kernels.hpp"
+
+
+// Single node removal probes
+#include "net_avalanche.hpp"
+
+
+/*-------------------------------------------------------------------------------
+ * Main function: Executes the following steps
+ * Builds a single network with poissonian degree distribution
+ * Randomly removes nodes with a percolation probability and prunes
+ * Probes every remaining node, avalanches are undone so all probes see the same network
+ * Repeats for different percolation probability
+ * Attacks are the same as those of Single_net_kcore_perco.cpp
+ * Returns int Exit code
+ -------------------------------------------------------------------------------*/
+
+
+int main(){
+
+
+  // Initialize the random number generator
+  initsrand(1);
+
+
+  // Number of nodes in each network
+  const int num_nodes = 1000000;
+
+
+  // Average degree for each network
+  float avg_degree = 10.0;
+
+  // kcore threshold values randomly chosen from
+  int threshold1, threshold2;
+
+
+  // Declare fraction of nodes set to have threshold1
+  double frac_of_nodes_thresh1;
+
+
+  // Percolation probability
+  double percolation_prob;
+
+
+  // Vector stoing node indices in largest cluster
+  vector<int> cluster_big;
+
+
+  // Number of probes with every avalanche size
+  vector<long> size_count;
+
+
+  // Read parameters for the network from a input file
+  cin >> threshold1;
+  cin >> frac_of_nodes_thresh1;
+  cin >> threshold2;
+
+
+  // Output files
+  ofstream output_file, hist_file;
+  string file_name, hist_file_name;
+
+
+  // Convert Parameter values to string for output filename
+
+  ostringstream ostr_num_nodes;
+  ostr_num_nodes << double(num_nodes);
+
+  ostringstream ostr_frac_thresh1;
+  ostr_frac_thresh1 << frac_of_nodes_thresh1;
+
+  ostringstream ostr_thresh1, ostr_thresh2;
+  ostr_thresh1 << threshold1;
+  ostr_thresh2 << threshold2;
+
+  ostringstream ostr_avg_degree;
+  ostr_avg_degree << avg_degree;
+
+  string file_params = "Nn"+ ostr_num_nodes.str()+"avgdeg_"+ ostr_avg_degree.str() +"L1_"+ ostr_thresh1.str()+"r_"+ ostr_frac_thresh1.str()+"L2_"+ ostr_thresh2.str()+".dat";
+  file_name = "./data/Avalanchevsprob" + file_params;
+  hist_file_name = "./data/Avalanche_hist" + file_params;
+
+
+  // Output run parameters to screen
+  cout << "Number of nodes in the network  = " << num_nodes  << endl;
+  cout << "\n Average degree of nodes in the network is " << avg_degree << endl;
+  cout << "\n kcore thresholds are: " <<  threshold1 << "  " << threshold2 << endl;
+  cout << "fraction of nodes with threshold1 is " << frac_of_nodes_thresh1 << endl;
+  cout << "data is written to " << file_name.c_str() << " and " << hist_file_name.c_str() << endl;
+
+
+  /*-------------------------------------------------------------------------------
+   * Build network and initialize
+   -------------------------------------------------------------------------------*/
+
+
+  // Create the network
+  Graph netA_initial(num_nodes);
+
+  // Build ER network
+  lt_ER_algo(netA_initial,avg_degree);
+
+
+  // Set local kcore thresholds for nodes
+  set_init_threshold_frac(netA_initial, threshold1, frac_of_nodes_thresh1, threshold2, 1.0 - frac_of_nodes_thresh1);
+
+
+  // Flat snapshot used by the simulation
+  Flat_graph netA(netA_initial);
+  Threshold_alphabet netA_thresholds(netA);
+  Threshold_array threshold(netA.threshold_data());
+
+
+  // Live degree of every node, the state of the network during a run
+  vector<int> live_degree;
+
+
+  // Probes reuse the buffers of the prober
+  Avalanche_prober prober;
+
+
+  /*-------------------------------------------------------------------------------
+   * Simulates percolation process
+  -------------------------------------------------------------------------------*/
+
+
+  output_file.open(file_name.c_str());
+  hist_file.open(hist_file_name.c_str());
+
+
+  // Set the step size for percolation prob increment
+  double delta_perco_prob = 0.005;
+
+
+  // Loop for different percolation probabilities
+  for(percolation_prob = 1.00 ; percolation_prob >= (1.0/avg_degree); percolation_prob -= delta_perco_prob)
+    {
+
+      reset_live_degree(netA, live_degree);
+      attack_and_prune(percolation_prob, netA, live_degree, netA_thresholds);
+
+      find_biggest_cluster(netA, live_degree, cluster_big);
+      double Giant_comp_frac = double(cluster_big.size())/double(num_nodes);
+
+
+      // Probe every node still linked to the network
+      long num_probes = 0, sum_size = 0, max_size = 0, sum_depth = 0;
+      size_count.assign(1, 0);
+
+      for (int node_idx = 0; node_idx < num_nodes; ++node_idx) {
+
+	int depth;
+	long size = prober.probe(netA, live_degree, threshold, node_idx, depth);
+	if (size == 0) continue;
+
+	++num_probes;
+	sum_size += size;
+	sum_depth += depth;
+	if (size > max_size) max_size = size;
+
+	if (size >= long(size_count.size())) size_count.resize(size + 1, 0);
+	++size_count[size];
+      }
+
+      double mean_size = num_probes ? double(sum_size) / num_probes : 0.0;
+      double mean_depth = num_probes ? double(sum_depth) / num_probes : 0.0;
+
+
+      // Output: 1-p, GC, number of probes, mean and largest avalanche size, mean depth
+      output_file << 1.0 - percolation_prob << "  " << Giant_comp_frac << "  " << num_probes << "  "
+		  << mean_size << "  " << max_size << "  " << mean_depth << endl;
+
+
+      // Distribution of avalanche sizes: 1-p, size, number of probes
+      for (size_t s = 1; s < size_count.size(); ++s)
+	if (size_count[s])
+	  hist_file << 1.0 - percolation_prob << "  " << s << "  " << size_count[s] << endl;
+
+    }
+
+
+  output_file.close();
+  hist_file.close();
+
+
+  return 0;
+}
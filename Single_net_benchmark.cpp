@@ -0,0 +1,738 @@
+/*-------------------------------------------------------------------------------
+ * Benchmarks of the percolation kernels on a single network
+ * Times the kernels against the general versions they replace and writes a
+ * table to the screen
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+using namespace std;
+#include <iostream>
+
+#include <fstream>
+#include <set>
+
+#include <string>
+#include <sstream>
+
+#include <chrono>
+#include <iomanip>
+
+#include <thread>
+
+#include <string.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+// Random number generator
+#include "./statool/srand.hpp"
+
+
+// Node and graph data structures
+#include "node.hpp"
+#include "graph.hpp"
+
+
+// Network building algorithm file
+#include "net_algo.hpp"
+
+
+// Percolation process functions on the list based network
+#include "net_ops.hpp"
+
+
+// Arena storage for the lists of the network
+#include "net_arena.hpp"
+
+
+// Percolation process functions on the flat snapshot of the network
+#include "net_ops_flat.hpp"
+
+
+// Attack and prune kernels specialized for the thresholds of the network
+#include "net_kernels.hpp"
+
+
+// Node orderings for memory locality
+#include "net_reorder.hpp"
+
+
+// Frontier pruning, serial and multi-threaded
+#include "net_parallel.hpp"
+
+
+// Configuration model network building
+#include "net_config_model.hpp"
+
+
+// Snapshot with compressed neighbor lists
+#include "net_compressed.hpp"
+
+
+// Huge pages, NUMA placement and thread pinning
+#include "net_placement.hpp"
+
+
+/*-------------------------------------------------------------------------------
+ * @Returns seconds elapsed since the input time point
+-------------------------------------------------------------------------------*/
+
+
+inline double seconds_since(chrono::steady_clock::time_point start)
+{
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+
+/*-------------------------------------------------------------------------------
+ * Counts last level cache misses of this process with the linux perf interface
+ * Reads -1 where hardware counters are not available (virtual machines, no permission)
+-------------------------------------------------------------------------------*/
+
+
+class Cache_miss_counter {
+
+protected:
+
+  int fd;
+
+public:
+
+  void start() {
+#ifdef __linux__
+    if (fd >= 0) { ioctl(fd, PERF_EVENT_IOC_RESET, 0); ioctl(fd, PERF_EVENT_IOC_ENABLE, 0); }
+#endif
+  }
+
+  long stop() {
+    long count = -1;
+#ifdef __linux__
+    if (fd >= 0) {
+      ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+      if (read(fd, &count, sizeof(count)) != sizeof(count)) count = -1;
+    }
+#endif
+    return count;
+  }
+
+  Cache_miss_counter() : fd(-1) {
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+  }
+
+  ~Cache_miss_counter() {
+#ifdef __linux__
+    if (fd >= 0) close(fd);
+#endif
+  }
+};
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot with thresholds set
+ * @param percolation probabilities to run
+ * @param number of repetitions of every percolation probability
+ * Prunes the same attacked network with the threshold array and with the specialized
+ * kernel, checks that both leave the same network after the same number of scans
+ * Attack time is shown for comparison
+-------------------------------------------------------------------------------*/
+
+
+void bench_prune_kernels(Flat_graph &net, const vector<double> &probs, int num_repeats)
+{
+  vector<int> attacked, degree_generic, degree_special;
+  Threshold_alphabet alphabet(net);
+
+  double time_attack = 0.0, time_generic = 0.0, time_special = 0.0;
+  long scans = 0;
+
+  for (size_t i = 0; i < probs.size(); ++i)
+    for (int r = 0; r < num_repeats; ++r) {
+
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      reset_live_degree(net, attacked);
+      initial_random_attack(probs[i], net, attacked);
+      time_attack += seconds_since(start);
+
+      degree_generic = attacked;
+      start = chrono::steady_clock::now();
+      int scans_generic = network_prune(net, degree_generic);
+      time_generic += seconds_since(start);
+
+      degree_special = attacked;
+      start = chrono::steady_clock::now();
+      int scans_special = network_prune(net, degree_special, alphabet);
+      time_special += seconds_since(start);
+
+      if (scans_generic != scans_special || degree_generic != degree_special) {
+	cerr << "specialized kernel differs from network_prune!" << endl;
+	exit(1);
+      }
+      scans += scans_generic;
+    }
+
+  cout << setw(12) << time_attack << setw(12) << time_generic << setw(12) << time_special
+       << setw(10) << time_generic / time_special << setw(10) << scans << endl;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param list based network with thresholds set
+ * @param node ordering of the snapshot
+ * @param percolation probabilities to run
+ * @param number of repetitions of every percolation probability
+ * Times snapshot with relabeling, attack, pruning and the biggest cluster search on
+ * a relabeled snapshot, with last level cache misses of the pruning and cluster search
+-------------------------------------------------------------------------------*/
+
+
+void bench_node_order(Graph &net_initial, Node_order order, const vector<double> &probs, int num_repeats)
+{
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  Flat_graph net(net_initial);
+  reorder_nodes(net, order);
+  double time_snapshot = seconds_since(start);
+
+  Threshold_alphabet alphabet(net);
+  vector<int> live_degree, cluster_big;
+  Cache_miss_counter counter;
+
+  double time_attack = 0.0, time_prune = 0.0, time_cluster = 0.0;
+  long misses_prune = 0, misses_cluster = 0;
+
+  for (size_t i = 0; i < probs.size(); ++i)
+    for (int r = 0; r < num_repeats; ++r) {
+
+      reset_live_degree(net, live_degree);
+      start = chrono::steady_clock::now();
+      initial_random_attack(probs[i], net, live_degree);
+      time_attack += seconds_since(start);
+
+      counter.start();
+      start = chrono::steady_clock::now();
+      network_prune(net, live_degree, alphabet);
+      time_prune += seconds_since(start);
+      long misses = counter.stop();
+      misses_prune = misses < 0 ? -1 : misses_prune + misses;
+
+      counter.start();
+      start = chrono::steady_clock::now();
+      find_biggest_cluster(net, live_degree, cluster_big);
+      time_cluster += seconds_since(start);
+      misses = counter.stop();
+      misses_cluster = misses < 0 ? -1 : misses_cluster + misses;
+    }
+
+  cout << setw(12) << time_snapshot << setw(12) << time_attack << setw(12) << time_prune
+       << setw(12) << time_cluster << setw(14) << misses_prune << setw(14) << misses_cluster << endl;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param list based network with thresholds set
+ * @param snapshot with the index types to time
+ * @param percolation probabilities to run
+ * @param number of repetitions of every percolation probability
+ * Shows the memory of the snapshot and times attack and pruning, and the biggest
+ * cluster search
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+void bench_index_width(Graph &net_initial, Flat_graph_t<Vertex, Offset> &net, const vector<double> &probs,
+		       int num_repeats)
+{
+  net.build_from(net_initial);
+  Threshold_alphabet alphabet(net);
+
+  vector<int> live_degree;
+  vector<Vertex> cluster_big;
+  double time_run = 0.0, time_cluster = 0.0;
+
+  for (size_t i = 0; i < probs.size(); ++i)
+    for (int r = 0; r < num_repeats; ++r) {
+
+      reset_live_degree(net, live_degree);
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      attack_and_prune(probs[i], net, live_degree, alphabet);
+      time_run += seconds_since(start);
+
+      start = chrono::steady_clock::now();
+      find_biggest_cluster(net, live_degree, cluster_big);
+      time_cluster += seconds_since(start);
+    }
+
+  cout << setw(12) << net.memory_bytes() / (1024 * 1024) << setw(14) << time_run << setw(12) << time_cluster << endl;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param list based network with thresholds set
+ * @param node ordering of the snapshot
+ * @param percolation probabilities to run
+ * @param number of repetitions of every percolation probability
+ * Shows bytes per link end of the neighbor blocks and times pruning and the biggest
+ * cluster search on the flat snapshot and on its compressed copy, the ratio of the
+ * times is the cost of decoding, checks that both leave the same network
+-------------------------------------------------------------------------------*/
+
+
+void bench_compressed(Graph &net_initial, Node_order order, const vector<double> &probs, int num_repeats)
+{
+  Flat_graph net(net_initial);
+  reorder_nodes(net, order);
+
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  Compressed_graph net_compressed(net);
+  double time_compress = seconds_since(start);
+
+  vector<int> attacked, degree_flat, degree_compressed, cluster_flat, cluster_compressed;
+  double time_prune_flat = 0.0, time_prune_compressed = 0.0;
+  double time_cluster_flat = 0.0, time_cluster_compressed = 0.0;
+
+  for (size_t i = 0; i < probs.size(); ++i)
+    for (int r = 0; r < num_repeats; ++r) {
+
+      reset_live_degree(net, attacked);
+      initial_random_attack(probs[i], net, attacked);
+
+      degree_flat = attacked;
+      start = chrono::steady_clock::now();
+      int scans_flat = network_prune(net, degree_flat);
+      time_prune_flat += seconds_since(start);
+
+      degree_compressed = attacked;
+      start = chrono::steady_clock::now();
+      int scans_compressed = network_prune(net_compressed, degree_compressed);
+      time_prune_compressed += seconds_since(start);
+
+      start = chrono::steady_clock::now();
+      find_biggest_cluster(net, degree_flat, cluster_flat);
+      time_cluster_flat += seconds_since(start);
+
+      start = chrono::steady_clock::now();
+      find_biggest_cluster(net_compressed, degree_compressed, cluster_compressed);
+      time_cluster_compressed += seconds_since(start);
+
+      if (scans_flat != scans_compressed || degree_flat != degree_compressed
+	  || cluster_flat.size() != cluster_compressed.size()) {
+	cerr << "compressed snapshot differs from the flat snapshot!" << endl;
+	exit(1);
+      }
+    }
+
+  double num_ends = 2.0 * net.get_num_edges();
+  cout << setw(10) << net.adjacency_bytes() / num_ends << setw(10) << net_compressed.adjacency_bytes() / num_ends
+       << setw(10) << time_compress << setw(10) << time_prune_flat << setw(10) << time_prune_compressed
+       << setw(10) << time_cluster_flat << setw(10) << time_cluster_compressed
+       << setw(10) << (time_prune_compressed + time_cluster_compressed) / (time_prune_flat + time_cluster_flat) << endl;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param list based network with thresholds set
+ * @param placement of the snapshot and of the live degree
+ * @param pin the threads of the multi-threaded frontier engine
+ * @param percolation probabilities to run
+ * @param number of repetitions of every percolation probability
+ * Places a new snapshot and times attack, pruning, the biggest cluster search and the
+ * multi-threaded frontier engine with one thread per cpu, shows the memory of the
+ * process in huge pages after placement
+-------------------------------------------------------------------------------*/
+
+
+void bench_placement(Graph &net_initial, const Memory_placement &placement, bool pinning, const vector<double> &probs,
+		     int num_repeats)
+{
+  Flat_graph net(net_initial);
+  vector<int> live_degree, attacked, cluster_big;
+  reset_live_degree(net, live_degree);
+  reset_live_degree(net, attacked);
+
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  bool placed = place_graph(net, placement) && place_vector(live_degree, placement) && place_vector(attacked, placement);
+  double time_place = seconds_since(start);
+  long huge_bytes = huge_page_bytes();
+
+  set_thread_pinning(pinning);
+  int num_threads = numa_topology().get_num_cpus();
+
+  double time_attack = 0.0, time_prune = 0.0, time_cluster = 0.0, time_parallel = 0.0;
+
+  for (size_t i = 0; i < probs.size(); ++i)
+    for (int r = 0; r < num_repeats; ++r) {
+
+      reset_live_degree(net, attacked);
+      start = chrono::steady_clock::now();
+      initial_random_attack(probs[i], net, attacked);
+      time_attack += seconds_since(start);
+
+      live_degree = attacked;
+      start = chrono::steady_clock::now();
+      network_prune(net, live_degree);
+      time_prune += seconds_since(start);
+
+      start = chrono::steady_clock::now();
+      find_biggest_cluster(net, live_degree, cluster_big);
+      time_cluster += seconds_since(start);
+
+      live_degree = attacked;
+      start = chrono::steady_clock::now();
+      network_prune_parallel(net, live_degree, num_threads);
+      time_parallel += seconds_since(start);
+    }
+
+  set_thread_pinning(false);
+
+  cout << setw(10) << (huge_bytes < 0 ? -1 : huge_bytes / (1024 * 1024)) << setw(8) << (placed ? "yes" : "no")
+       << setw(10) << time_place << setw(10) << time_attack << setw(10) << time_prune << setw(10) << time_cluster
+       << setw(10) << time_parallel << endl;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot with thresholds set
+ * @param percolation probabilities to run
+ * @param thread counts of the multi-threaded frontier engine
+ * Prunes the same attacked network with the scan engine, the serial frontier engine and
+ * the multi-threaded frontier engine, checks that all leave the same kcore and that both
+ * frontier engines count the same generations
+-------------------------------------------------------------------------------*/
+
+
+void bench_parallel_prune(Flat_graph &net, const vector<double> &probs, const vector<int> &thread_counts)
+{
+  vector<int> attacked, degree_scan, degree_frontier, degree_parallel;
+
+  double time_scan = 0.0, time_frontier = 0.0;
+  vector<double> time_parallel(thread_counts.size(), 0.0);
+  long generations = 0;
+
+  for (size_t i = 0; i < probs.size(); ++i) {
+
+    reset_live_degree(net, attacked);
+    initial_random_attack(probs[i], net, attacked);
+
+    degree_scan = attacked;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    network_prune(net, degree_scan);
+    time_scan += seconds_since(start);
+
+    degree_frontier = attacked;
+    start = chrono::steady_clock::now();
+    int generations_frontier = network_prune_frontier(net, degree_frontier);
+    time_frontier += seconds_since(start);
+    generations += generations_frontier;
+
+    if (degree_frontier != degree_scan) {
+      cerr << "frontier engine differs from network_prune!" << endl;
+      exit(1);
+    }
+
+    for (size_t t = 0; t < thread_counts.size(); ++t) {
+      degree_parallel = attacked;
+      start = chrono::steady_clock::now();
+      int generations_parallel = network_prune_parallel(net, degree_parallel, thread_counts[t]);
+      time_parallel[t] += seconds_since(start);
+
+      if (generations_parallel != generations_frontier || degree_parallel != degree_frontier) {
+	cerr << "multi-threaded frontier engine differs from the serial one!" << endl;
+	exit(1);
+      }
+    }
+  }
+
+  cout << setw(12) << time_scan << setw(12) << time_frontier;
+  for (size_t t = 0; t < thread_counts.size(); ++t) cout << setw(12) << time_parallel[t];
+  cout << setw(12) << generations << endl;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param list based network with thresholds set
+ * @param network to copy into, lists kept by its allocator
+ * @param percolation probabilities to run
+ * Times the copy of the network, attack and pruning of the copy, and freeing
+ * the lists of the copy, once for every percolation probability
+-------------------------------------------------------------------------------*/
+
+
+template <class Alloc>
+void bench_list_storage(Graph &net_initial, Graph_t<Alloc> &net, const vector<double> &probs)
+{
+  double time_copy = 0.0, time_run = 0.0, time_free = 0.0;
+
+  for (size_t i = 0; i < probs.size(); ++i) {
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    net.copy_from(net_initial);
+    time_copy += seconds_since(start);
+
+    start = chrono::steady_clock::now();
+    initial_random_attack(probs[i], net);
+    network_prune(net);
+    time_run += seconds_since(start);
+
+    start = chrono::steady_clock::now();
+    net.resize(0);
+    time_free += seconds_since(start);
+  }
+
+  cout << setw(12) << time_copy << setw(14) << time_run << setw(12) << time_free << endl;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * Main function: builds one network and runs every benchmark on it
+ * Returns int Exit code
+ -------------------------------------------------------------------------------*/
+
+
+int main(){
+
+
+  // Initialize the random number generator, seeds are not updated
+  initsrand(0);
+
+
+  // Number of nodes in the network
+  const int num_nodes = 1000000;
+
+
+  // Average degree of the network
+  float avg_degree = 10.0;
+
+
+  // Number of repetitions of every measurement
+  const int num_repeats = 3;
+
+
+  // Percolation probabilities around the transitions of the configurations below
+  vector<double> probs;
+  for (double p = 0.95; p > 0.3; p -= 0.05) probs.push_back(p);
+
+
+  cout << "Number of nodes in the network  = " << num_nodes << endl;
+  cout << "Average degree of nodes in the network is " << avg_degree << endl;
+
+
+  Graph netA_initial(num_nodes);
+  lt_ER_algo(netA_initial, avg_degree);
+
+
+  /*-------------------------------------------------------------------------------
+   * Pruning: threshold array against specialized kernels
+   -------------------------------------------------------------------------------*/
+
+
+  cout << "\nprune after attack, seconds" << endl;
+  cout << setw(16) << "thresholds" << setw(12) << "attack" << setw(12) << "array" << setw(12) << "special"
+       << setw(10) << "speedup" << setw(10) << "scans" << endl;
+
+
+  // Threshold configurations: threshold1, fraction with threshold1, threshold2
+  int config_thresh1[] = {2, 3, 1, 2, 7, 2};
+  double config_frac[] = {1.0, 1.0, 0.5, 0.5, 1.0, 0.4};
+  int config_thresh2[] = {2, 3, 2, 3, 7, 3};
+  int num_configs = 6;
+
+  for (int c = 0; c < num_configs; ++c) {
+
+    set_init_threshold_frac(netA_initial, config_thresh1[c], config_frac[c], config_thresh2[c], 1.0 - config_frac[c]);
+
+    // Mixed configuration with a third threshold falls back to the threshold array
+    if (c == num_configs - 1)
+      for (int i = 0; i < num_nodes; i += 10) netA_initial.set_threshold(i, 4);
+
+    Flat_graph netA(netA_initial);
+
+    ostringstream ostr_config;
+    ostr_config << config_thresh1[c] << "," << config_thresh2[c] << (c == num_configs - 1 ? ",4" : "");
+    cout << setw(16) << ostr_config.str();
+
+    bench_prune_kernels(netA, probs, num_repeats);
+  }
+
+
+  /*-------------------------------------------------------------------------------
+   * Node orderings: attack, prune and cluster search on relabeled snapshots
+   -------------------------------------------------------------------------------*/
+
+
+  cout << "\nnode order with thresholds 2,3, seconds and last level cache misses (-1: no counters)" << endl;
+  cout << setw(16) << "order" << setw(12) << "snapshot" << setw(12) << "attack" << setw(12) << "prune"
+       << setw(12) << "cluster" << setw(14) << "miss prune" << setw(14) << "miss cluster" << endl;
+
+  set_init_threshold_frac(netA_initial, 2, 0.5, 3, 0.5);
+
+  const char *order_names[] = {"none", "bfs", "rcm", "degree"};
+  Node_order orders[] = {order_none, order_bfs, order_rcm, order_degree};
+
+  for (int o = 0; o < 4; ++o) {
+    cout << setw(16) << order_names[o];
+    bench_node_order(netA_initial, orders[o], probs, num_repeats);
+  }
+
+
+  /*-------------------------------------------------------------------------------
+   * Index types of the snapshot: memory and run time
+   -------------------------------------------------------------------------------*/
+
+
+  cout << "\nsnapshot index types with thresholds 2,3, MB and seconds" << endl;
+  cout << setw(16) << "node,offset" << setw(12) << "MB" << setw(14) << "attack+prune" << setw(12) << "cluster" << endl;
+
+  {
+    Flat_graph net_default;
+    cout << setw(16) << "int,long";
+    bench_index_width(netA_initial, net_default, probs, num_repeats);
+
+    Flat_graph_32 net_32;
+    cout << setw(16) << "32,32";
+    bench_index_width(netA_initial, net_32, probs, num_repeats);
+
+    Flat_graph_64 net_64;
+    cout << setw(16) << "64,64";
+    bench_index_width(netA_initial, net_64, probs, num_repeats);
+  }
+
+
+  /*-------------------------------------------------------------------------------
+   * Compressed neighbor lists: memory against decoding time
+   -------------------------------------------------------------------------------*/
+
+
+  cout << "\ncompressed neighbor lists with thresholds 2,3, bytes per link end and seconds" << endl;
+  cout << setw(16) << "order" << setw(10) << "B flat" << setw(10) << "B comp" << setw(10) << "compress"
+       << setw(10) << "prune" << setw(10) << "prune c" << setw(10) << "cluster" << setw(10) << "cluster c"
+       << setw(10) << "ratio" << endl;
+
+  for (int o = 0; o < 4; ++o) {
+    cout << setw(16) << order_names[o];
+    bench_compressed(netA_initial, orders[o], probs, num_repeats);
+  }
+
+
+  /*-------------------------------------------------------------------------------
+   * Memory placement: huge pages, NUMA nodes and pinned threads
+   -------------------------------------------------------------------------------*/
+
+
+  cout << "\nmemory placement with thresholds 2,3 on " << numa_topology().get_num_nodes() << " NUMA nodes and "
+       << numa_topology().get_num_cpus() << " cpus, MB in huge pages and seconds" << endl;
+  cout << setw(24) << "placement" << setw(10) << "huge MB" << setw(8) << "placed" << setw(10) << "place"
+       << setw(10) << "attack" << setw(10) << "prune" << setw(10) << "cluster" << setw(10) << "parallel" << endl;
+
+  {
+    const char *placement_names[] = {"default", "huge pages", "interleave", "partition",
+				     "huge,interleave,pinned", "huge,partition,pinned"};
+    Memory_placement placements[] = {Memory_placement(),
+				     Memory_placement(pages_huge),
+				     Memory_placement(pages_default, nodes_interleave),
+				     Memory_placement(pages_default, nodes_partition),
+				     Memory_placement(pages_huge, nodes_interleave),
+				     Memory_placement(pages_huge, nodes_partition)};
+
+    for (int m = 0; m < 6; ++m) {
+      cout << setw(24) << placement_names[m];
+      bench_placement(netA_initial, placements[m], m >= 4, probs, num_repeats);
+    }
+  }
+
+
+  /*-------------------------------------------------------------------------------
+   * Frontier pruning: serial against multi-threaded generations
+   -------------------------------------------------------------------------------*/
+
+
+  vector<int> thread_counts;
+  thread_counts.push_back(2);
+  thread_counts.push_back(4);
+  if (int(thread::hardware_concurrency()) > 4) thread_counts.push_back(thread::hardware_concurrency());
+
+  cout << "\nprune after attack with thresholds 2,3, seconds" << endl;
+  cout << setw(12) << "scans" << setw(12) << "frontier";
+  for (size_t t = 0; t < thread_counts.size(); ++t) cout << setw(9) << thread_counts[t] << " th";
+  cout << setw(12) << "generations" << endl;
+
+  {
+    Flat_graph netA(netA_initial);
+    bench_parallel_prune(netA, probs, thread_counts);
+  }
+
+
+  /*-------------------------------------------------------------------------------
+   * List storage: heap allocated nodes against an arena reset between copies
+   -------------------------------------------------------------------------------*/
+
+
+  cout << "\nlist network copies with thresholds 2,3, seconds" << endl;
+  cout << setw(16) << "storage" << setw(12) << "copy" << setw(14) << "attack+prune" << setw(12) << "free" << endl;
+
+  vector<double> probs_list;
+  for (double p = 0.9; p > 0.4; p -= 0.2) probs_list.push_back(p);
+
+  Graph netA_heap(0);
+  cout << setw(16) << "heap";
+  bench_list_storage(netA_initial, netA_heap, probs_list);
+
+  Arena arena;
+  Graph_t<Arena_allocator<int> > netA_arena(0, Arena_allocator<int>(&arena));
+  cout << setw(16) << "arena";
+  bench_list_storage(netA_initial, netA_arena, probs_list);
+  cout << "arena capacity " << arena.get_capacity() / (1024 * 1024) << " MB" << endl;
+
+
+  /*-------------------------------------------------------------------------------
+   * Configuration model: power law network of 10^7 nodes, k from 2 to sqrt(N)
+   -------------------------------------------------------------------------------*/
+
+
+  cout << "\nconfiguration model, power law 2.5, seconds" << endl;
+  cout << setw(12) << "nodes" << setw(12) << "threads" << setw(12) << "degrees" << setw(12) << "links"
+       << setw(12) << "edges" << setw(12) << "dropped" << endl;
+
+  {
+    const int num_nodes_cm = 10000000;
+    vector<double> cdf;
+    degree_distribution_cdf(degrees_power_law, 0.0, 2.5, 2, int(sqrt(double(num_nodes_cm))), 0.0, cdf);
+
+    vector<int> threads_cm;
+    threads_cm.push_back(1);
+    threads_cm.insert(threads_cm.end(), thread_counts.begin(), thread_counts.end());
+
+    for (size_t t = 0; t < threads_cm.size(); ++t) {
+
+      vector<int> degree;
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      sample_degrees(cdf, num_nodes_cm, 1, degree, threads_cm[t]);
+      make_degree_sum_even(degree);
+      double time_degrees = seconds_since(start);
+
+      Flat_graph net_cm;
+      start = chrono::steady_clock::now();
+      long num_dropped = configuration_model(degree, 2, net_cm, threads_cm[t]);
+      double time_links = seconds_since(start);
+
+      cout << setw(12) << num_nodes_cm << setw(12) << threads_cm[t] << setw(12) << time_degrees
+	   << setw(12) << time_links << setw(12) << net_cm.get_num_edges() << setw(12) << num_dropped << endl;
+    }
+  }
+
+
+  return 0;
+}
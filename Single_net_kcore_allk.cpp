@@ -0,0 +1,169 @@
+/*-------------------------------------------------------------------------------
+ * Simulates k-core percolation on single network for every uniform threshold
+ * Calcualtes biggest cluster size of the k-core for k = 1 .. k_max as a function
+ * of percolation probability, from one core decomposition per attack
+ * Networks with mixed thresholds are simulated by Single_net_kcore_perco.cpp
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+using namespace std;
+#include <iostream>
+
+#include <fstream>
+#include <set>
+
+#include <string>
+#include <sstream>
+
+
+// Random number generator
+#include "./statool/srand.hpp"
+
+
+// Node and graph data structures
+#include "node.hpp"
+#include "graph.hpp"
+
+
+// Network building algorithm file
+#include "net_algo.hpp"
+
+
+// Percolation process functions on the flat snapshot of the network
+#include "net_ops_flat.hpp"
+
+
+// Core decomposition
+#include "net_cores.hpp"
+
+
+/*-------------------------------------------------------------------------------
+ * Main function: Executes the following steps
+ * Builds a single network with poissonian degree distribution
+ * Randomly removes nodes with a percolation probability
+ * Finds the core number of every node and the largest cluster of every k-core
+ * Repeats for different percolation probability
+ * Attacks are the same as those of Single_net_kcore_perco.cpp, so column k equals its
+ * output for thresholds k, 1, k
+ * Returns int Exit code
+ -------------------------------------------------------------------------------*/
+
+
+int main(){
+
+
+  // Initialize the random number generator
+  initsrand(1);
+
+
+  // Number of nodes in each network
+  const int num_nodes = 1000000;
+
+
+  // Average degree for each network
+  float avg_degree = 10.0;
+
+
+  // Largest kcore threshold written to the output
+  const int k_max = 8;
+
+
+  // Percolation probability
+  double percolation_prob;
+
+
+  // Live degree and core number of every node
+  vector<int> live_degree, core;
+
+
+  // Biggest cluster size of the k-core for every k
+  vector<long> biggest_size;
+
+
+  // Output file
+  ofstream output_file;
+  string file_name;
+
+
+  // Convert Parameter values to string for output filename
+
+  ostringstream ostr_num_nodes;
+  ostr_num_nodes << double(num_nodes);
+
+  ostringstream ostr_avg_degree;
+  ostr_avg_degree << avg_degree;
+
+  ostringstream ostr_k_max;
+  ostr_k_max << k_max;
+
+  file_name="./data/GCvsprob_allkNn"+ ostr_num_nodes.str()+"avgdeg_"+ ostr_avg_degree.str() +"kmax_"+ ostr_k_max.str()+".dat";
+
+
+  // Output run parameters to screen
+  cout << "Number of nodes in the network  = " << num_nodes  << endl;
+  cout << "\n Average degree of nodes in the network is " << avg_degree << endl;
+  cout << "\n kcore thresholds are: 1 to " << k_max << endl;
+  cout << "data is written to " << file_name.c_str() << endl;
+
+
+  /*-------------------------------------------------------------------------------
+   * Build network and initialize
+   -------------------------------------------------------------------------------*/
+
+
+  // Create the network
+  Graph netA_initial(num_nodes);
+
+  // Build ER network
+  lt_ER_algo(netA_initial,avg_degree);
+
+
+  // Thresholds are not used, they are drawn so the attacks use the same random numbers
+  // as those of Single_net_kcore_perco.cpp
+  set_init_threshold_frac(netA_initial, 1, 1.0, 1, 0.0);
+
+
+  // Flat snapshot used by the simulation
+  Flat_graph netA(netA_initial);
+
+
+  /*-------------------------------------------------------------------------------
+   * Simulates percolation process
+  -------------------------------------------------------------------------------*/
+
+
+  output_file.open(file_name.c_str());
+
+
+  // Set the step size for percolation prob increment
+  double delta_perco_prob = 0.005;
+
+
+  // Loop for different percolation probabilities
+  for(percolation_prob = 1.00 ; percolation_prob >= (1.0/avg_degree); percolation_prob -= delta_perco_prob)
+    {
+
+      // Remove randomly chosen nodes
+      reset_live_degree(netA, live_degree);
+      initial_random_attack(percolation_prob, netA, live_degree);
+
+
+      // Core numbers answer every uniform threshold at once
+      core_numbers(netA, live_degree, core);
+      biggest_kcore_clusters(netA, core, k_max, biggest_size);
+
+
+      // Output giant component fraction of the k-core for k = 1 .. k_max
+      output_file << 1.0 - percolation_prob;
+      for (int k = 1; k <= k_max; ++k)
+	output_file << "  " << double(biggest_size[k]) / double(num_nodes);
+      output_file << endl;
+
+    }
+
+
+  output_file.close();
+
+
+  return 0;
+}
@@ -0,0 +1,216 @@
+/*-------------------------------------------------------------------------------
+ * Simulates k-core bond percolation on single network
+ * Calcualtes biggest cluster size as a function of the fraction of links that do not
+ * fail, links fail in one random order so every step only fails the new links
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+using namespace std;
+#include <iostream>
+
+#include <fstream>
+#include <set>
+
+#include <string>
+#include <sstream>
+
+
+// Random number generator
+#include "./statool/srand.hpp"
+
+
+// Node and graph data structures
+#include "node.hpp"
+#include "graph.hpp"
+
+
+// Network building algorithm file
+#include "net_algo.hpp"
+
+
+// Percolation process functions on the flat snapshot of the network
+#include "net_ops_flat.hpp"
+
+
+// Bond percolation on the flat snapshot
+#include "net_bond.hpp"
+
+
+// Early exit and lazy biggest cluster search
+#include "net_lazy.hpp"
+
+
+/*-------------------------------------------------------------------------------
+ * Main function: Executes the following steps
+ * Builds a single network with poissonian degree distribution
+ * Prunes the whole network, then for every percolation probability fails the next
+ * links of a random order and prunes again
+ * Finds the largest kcore cluster
+ * Returns int Exit code
+ -------------------------------------------------------------------------------*/
+
+
+int main(){
+
+
+  // Initialize the random number generator
+  initsrand(1);
+
+
+  // Number of nodes in each network
+  const int num_nodes = 1000000;
+
+
+  // Average degree for each network
+  float avg_degree = 10.0;
+
+  // kcore threshold values randomly chosen from
+  int threshold1, threshold2;
+
+
+  // Declare fraction of nodes set to have threshold1
+  double frac_of_nodes_thresh1;
+
+
+  // Number of pruning iterations of a step
+  int num_of_prune_iterations;
+
+
+  // Vector stoing node indices in largest cluster
+  vector<int> cluster_big;
+
+
+  // Read parameters for the network from a input file
+  cin >> threshold1;
+  cin >> frac_of_nodes_thresh1;
+  cin >> threshold2;
+
+
+  // Output file
+  ofstream output_file;
+  string file_name;
+
+
+  // Convert Parameter values to string for output filename
+
+  ostringstream ostr_num_nodes;
+  ostr_num_nodes << double(num_nodes);
+
+  ostringstream ostr_frac_thresh1;
+  ostr_frac_thresh1 << frac_of_nodes_thresh1;
+
+  ostringstream ostr_thresh1, ostr_thresh2;
+  ostr_thresh1 << threshold1;
+  ostr_thresh2 << threshold2;
+
+  ostringstream ostr_avg_degree;
+  ostr_avg_degree << avg_degree;
+
+  file_name="./data/GCvsprob_bondNn"+ ostr_num_nodes.str()+"avgdeg_"+ ostr_avg_degree.str() +"L1_"+ ostr_thresh1.str()+"r_"+ ostr_frac_thresh1.str()+"L2_"+ ostr_thresh2.str()+".dat";
+
+
+  // Output run parameters to screen
+  cout << "Number of nodes in the network  = " << num_nodes  << endl;
+  cout << "\n Average degree of nodes in the network is " << avg_degree << endl;
+  cout << "\n kcore thresholds are: " <<  threshold1 << "  " << threshold2 << endl;
+  cout << "fraction of nodes with threshold1 is " << frac_of_nodes_thresh1 << endl;
+  cout << "data is written to " << file_name.c_str() << endl;
+
+
+  /*-------------------------------------------------------------------------------
+   * Build network and initialize
+   -------------------------------------------------------------------------------*/
+
+
+  // Create the network
+  Graph netA_initial(num_nodes);
+
+  // Build ER network
+  lt_ER_algo(netA_initial,avg_degree);
+
+
+  // Set local kcore thresholds for nodes
+  set_init_threshold_frac(netA_initial, threshold1, frac_of_nodes_thresh1, threshold2, 1.0 - frac_of_nodes_thresh1);
+
+
+  // Flat snapshot used by the simulation
+  Flat_graph netA(netA_initial);
+
+
+  // Link array of the snapshot and random failure order
+  Bond_links<> netA_links(netA);
+  netA_links.random_order();
+
+
+  // Live degree of every node, the state of the network during the sweep
+  vector<int> live_degree;
+  netA_links.reset(netA, live_degree);
+
+
+  // Nodes below their threshold after the links of a step failed
+  vector<uint64_t> candidates;
+
+
+  // Shortcuts of the biggest cluster search, failed links of different steps are nested
+  Lazy_sweep lazy_sweep(true);
+  long biggest_size;
+
+
+  /*-------------------------------------------------------------------------------
+   * Simulates percolation process
+  -------------------------------------------------------------------------------*/
+
+
+  output_file.open(file_name.c_str());
+
+
+  // Set the step size for percolation prob increment
+  double delta_perco_prob = 0.005;
+
+
+  // Loop for different percolation probabilities, every step starts from the state of the last
+  for (double percolation_prob = 1.00 ; percolation_prob >= (1.0/avg_degree); percolation_prob -= delta_perco_prob)
+    {
+
+      // No live node left: every later step is empty and prunes in one scan
+      if (lazy_sweep.collapsed()) {
+	output_file << 1.0 - percolation_prob <<"  "<< 1.0/double(num_nodes)  << "  " << 1 << endl;
+	lazy_sweep.skip_steps(1);
+	continue;
+      }
+
+
+      // Fail the next links, the whole network is checked at the first step
+      netA_links.fail_links(num_failed_links(percolation_prob, netA_links.get_num_links()), netA, live_degree, candidates);
+      if (percolation_prob == 1.00)
+	find_prune_candidates(live_degree.data(), netA.threshold_data(), num_nodes, candidates);
+
+
+      // Remove nodes with degree less than the local threshold
+      num_of_prune_iterations = bond_network_prune(netA, netA_links, live_degree, candidates);
+
+
+      // Find the biggest cluster, unless no node is live or no live link failed
+      if (!lazy_sweep.size_known(live_degree, num_nodes, biggest_size)) {
+	bond_find_biggest_cluster(netA, netA_links, live_degree, cluster_big);
+	biggest_size = cluster_big.size();
+	lazy_sweep.searched(biggest_size, lazy_sweep.get_num_live());
+      }
+      double Giant_comp_frac = double(biggest_size)/double(num_nodes);
+
+
+      // Output result to file
+      output_file << 1.0 - percolation_prob <<"  "<< Giant_comp_frac  << "  " << num_of_prune_iterations << endl;
+
+    }
+
+
+  output_file.close();
+
+
+  // Work done and skipped by the shortcuts
+  lazy_sweep.report(cout);
+
+
+  return 0;
+}
@@ -0,0 +1,272 @@
+/*-------------------------------------------------------------------------------
+ * Simulates k-core percolation on single configuration model network
+ * Calcualtes biggest cluster size as a function of percolation probability for a
+ * network with Poisson, power law or bimodal degree distribution, or with the degree
+ * sequence of a file
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+using namespace std;
+#include <iostream>
+
+#include <fstream>
+#include <set>
+
+#include <string>
+#include <sstream>
+
+
+// Random number generator
+#include "./statool/srand.hpp"
+
+
+// Node and graph data structures
+#include "node.hpp"
+#include "graph.hpp"
+
+
+// Percolation process functions on the flat snapshot of the network
+#include "net_ops_flat.hpp"
+
+
+// Attack and prune kernels specialized for the thresholds of the network
+#include "net_kernels.hpp"
+
+
+// Configuration model network building
+#include "net_config_model.hpp"
+
+
+/*-------------------------------------------------------------------------------
+ * @param degree of every node, with an even sum
+ * @param seed of the network
+ * @param snapshot to build, its index types fit the network
+ * @params threshold values and the fraction of nodes with the first one
+ * @param number of threads building the network
+ * @param output file name
+ * Builds the network, then for every percolation probability randomly removes nodes,
+ * prunes and finds the largest kcore cluster
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+void percolation_sweep(const vector<int> &degree, uint64_t seed, Flat_graph_t<Vertex, Offset> &netA,
+		       int threshold1, double frac_of_nodes_thresh1, int threshold2, int num_threads,
+		       const string &file_name)
+{
+  Vertex num_nodes = degree.size();
+
+
+  // Links from shuffled stubs, self-loops and multiple links dropped
+  long num_dropped = configuration_model(degree, seed, netA, num_threads);
+
+
+  // Set local kcore thresholds for nodes
+  set_init_threshold_frac(netA, threshold1, frac_of_nodes_thresh1, threshold2, 1.0 - frac_of_nodes_thresh1);
+
+
+  // Thresholds of the network, used to choose the attack and prune kernel
+  Threshold_alphabet netA_thresholds(netA);
+
+
+  // Live degree of every node, the state of the network during a run
+  vector<int> live_degree;
+
+
+  // Vector stoing node indices in largest cluster
+  vector<Vertex> cluster_big;
+
+
+  double mean_degree = 2.0 * netA.get_num_edges() / num_nodes;
+  cout << " average degree " << mean_degree << endl;
+  cout << " stub pairs dropped as self-loops or multiple links: " << num_dropped << endl;
+  cout << " node index " << 8 * sizeof(Vertex) << " bit, offsets " << 8 * sizeof(Offset) << " bit, "
+       << netA.memory_bytes() / (1024 * 1024) << " MB" << endl;
+
+
+  ofstream output_file(file_name.c_str());
+
+
+  // Set the step size for percolation prob increment
+  double delta_perco_prob = 0.005;
+
+
+  // Loop for different percolation probabilities
+  for (double percolation_prob = 1.00 ; percolation_prob >= (1.0/mean_degree); percolation_prob -= delta_perco_prob)
+    {
+
+      reset_live_degree(netA, live_degree);
+
+
+      // Remove randomly chosen nodes, then remove nodes with degree less than the local threshold
+      int num_of_prune_iterations = attack_and_prune(percolation_prob, netA, live_degree, netA_thresholds);
+
+
+      // Find the biggest cluster
+      find_biggest_cluster(netA, live_degree, cluster_big);
+      double Giant_comp_frac = double(cluster_big.size())/double(num_nodes);
+
+
+      // Output result to file
+      output_file << 1.0 - percolation_prob <<"  "<< Giant_comp_frac  << "  " << num_of_prune_iterations << endl;
+
+    }
+
+
+  output_file.close();
+}
+
+
+/*-------------------------------------------------------------------------------
+ * Main function: Executes the following steps
+ * Builds a single configuration model network with the smallest index types that fit
+ * Randomly removes nodes with a percolation probability
+ * Finds the largest kcore cluster
+ * Repeats for different percolation probability
+ * Returns int Exit code
+ -------------------------------------------------------------------------------*/
+
+
+int main(){
+
+
+  // Initialize the random number generator
+  initsrand(1);
+
+
+  // Number of nodes in the network, replaced by the length of the degree file if one is given
+  long num_nodes = 1000000;
+
+
+  // Degree distribution (degrees_poisson, degrees_power_law, degrees_bimodal)
+  const Degree_distribution distribution = degrees_power_law;
+
+
+  // Poisson: average degree
+  const double avg_degree = 10.0;
+
+
+  // Power law P(k) ~ k^-gamma for k_low <= k <= k_high, bimodal: fraction frac_low with k_low, others k_high
+  const double gamma = 2.5;
+  const int k_low = 2;
+  const int k_high = 1000;
+  const double frac_low = 0.5;
+
+
+  // File with the degree of every node, one per line, used instead of the distribution if not empty
+  const string degree_file = "";
+
+
+  // Number of threads building the network, 0 for all hardware threads
+  const int num_threads = 0;
+
+
+  // kcore threshold values randomly chosen from
+  int threshold1, threshold2;
+
+
+  // Declare fraction of nodes set to have threshold1
+  double frac_of_nodes_thresh1;
+
+
+  // Read parameters for the network from a input file
+  cin >> threshold1;
+  cin >> frac_of_nodes_thresh1;
+  cin >> threshold2;
+
+
+  /*-------------------------------------------------------------------------------
+   * Build network and initialize
+   -------------------------------------------------------------------------------*/
+
+
+  // Degree sequence
+  vector<int> degree;
+  string degree_name;
+
+  if (!degree_file.empty()) {
+    if (!read_degree_sequence(degree_file.c_str(), degree)) {
+      cerr << "'" << degree_file << "' could not be read." << endl;
+      exit(1);
+    }
+    num_nodes = degree.size();
+    degree_name = "file";
+  }
+  else {
+    vector<double> cdf;
+    degree_distribution_cdf(distribution, avg_degree, gamma, k_low, k_high, frac_low, cdf);
+    sample_degrees(cdf, num_nodes, uint64_t(srand() * 4294967296.0), degree, num_threads);
+
+    ostringstream ostr_degree;
+    if (distribution == degrees_poisson) ostr_degree << "poisson_" << avg_degree;
+    if (distribution == degrees_power_law) ostr_degree << "powerlaw_" << gamma << "_" << k_low << "_" << k_high;
+    if (distribution == degrees_bimodal) ostr_degree << "bimodal_" << k_low << "_" << k_high << "_" << frac_low;
+    degree_name = ostr_degree.str();
+  }
+
+  make_degree_sum_even(degree);
+
+  long num_link_ends = 0;
+  for (long i = 0; i < num_nodes; ++i) num_link_ends += degree[i];
+
+
+  // Seed of the network
+  uint64_t seed = uint64_t(srand() * 4294967296.0);
+
+
+  // Output file
+  string file_name;
+
+
+  // Convert Parameter values to string for output filename
+
+  ostringstream ostr_num_nodes;
+  ostr_num_nodes << double(num_nodes);
+
+  ostringstream ostr_frac_thresh1;
+  ostr_frac_thresh1 << frac_of_nodes_thresh1;
+
+  ostringstream ostr_thresh1, ostr_thresh2;
+  ostr_thresh1 << threshold1;
+  ostr_thresh2 << threshold2;
+
+  file_name="./data/GCvsprob_cmNn"+ ostr_num_nodes.str()+"deg_"+ degree_name +"L1_"+ ostr_thresh1.str()+"r_"+ ostr_frac_thresh1.str()+"L2_"+ ostr_thresh2.str()+".dat";
+
+
+  // Output run parameters to screen
+  cout << "Number of nodes in the network  = " << num_nodes  << endl;
+  cout << "\n kcore thresholds are: " <<  threshold1 << "  " << threshold2 << endl;
+  cout << "fraction of nodes with threshold1 is " << frac_of_nodes_thresh1 << endl;
+  cout << "data is written to " << file_name.c_str() << endl;
+  cout << "\n Degree distribution " << degree_name << endl;
+
+
+  /*-------------------------------------------------------------------------------
+   * Simulates percolation process with the smallest index types for the network
+  -------------------------------------------------------------------------------*/
+
+
+  switch (select_index_width(num_nodes, num_link_ends)) {
+
+  case index_32: {
+    Flat_graph_32 netA;
+    percolation_sweep(degree, seed, netA, threshold1, frac_of_nodes_thresh1, threshold2, num_threads, file_name);
+    break;
+  }
+
+  case index_32_64: {
+    Flat_graph_32_64 netA;
+    percolation_sweep(degree, seed, netA, threshold1, frac_of_nodes_thresh1, threshold2, num_threads, file_name);
+    break;
+  }
+
+  case index_64: {
+    Flat_graph_64 netA;
+    percolation_sweep(degree, seed, netA, threshold1, frac_of_nodes_thresh1, threshold2, num_threads, file_name);
+    break;
+  }
+  }
+
+
+  return 0;
+}
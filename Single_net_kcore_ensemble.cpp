@@ -0,0 +1,292 @@
+/*-------------------------------------------------------------------------------
+ * Simulates k-core percolation on single network for an ensemble of attacks
+ * Calcualtes the average biggest cluster size over random attacks as a function
+ * of percolation probability, 64 attacks are simulated together bit parallel
+ * Batches of 64 attacks run on different threads, network, thresholds and attacks
+ * draw from random number streams (net_deterministic.hpp), so the output file is the
+ * same for any number of threads
+ * Started as './kcore_ensemble_exe verify < input_parameters' the job is run with 1, 4
+ * and all hardware threads and the outputs are compared
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+using namespace std;
+#include <iostream>
+
+#include <fstream>
+#include <set>
+
+#include <string>
+#include <sstream>
+
+#include <cmath>
+
+#include <thread>
+
+
+// Random number generator
+#include "./statool/srand.hpp"
+
+
+// Node and graph data structures
+#include "node.hpp"
+#include "graph.hpp"
+
+
+// Bit parallel percolation process functions
+#include "net_bitpar.hpp"
+
+
+// Network, thresholds and attacks independent of the number of threads
+#include "net_deterministic.hpp"
+
+
+// Huge pages, NUMA placement and thread pinning
+#include "net_placement.hpp"
+
+
+// Survival probability of every node
+#include "net_survival.hpp"
+
+
+/*-------------------------------------------------------------------------------
+ * @param number of nodes
+ * @param average degree
+ * @params threshold values and the fraction of nodes with the first one
+ * @param number of batches of 64 attacks for every percolation probability
+ * @param seed of the random number streams
+ * @param number of threads, 0 for all hardware threads
+ * @param start of the names of the survival files, empty for none
+ * Builds the network, then for every percolation probability attacks num_batches*64
+ * copies of the network, finds the largest kcore cluster of every copy and averages
+ * Attacks of probability step s are numbered from s*num_batches*64, batch b runs
+ * attacks b*64 .. b*64+63 of the step on whichever thread is free
+ * With survival files, the number of attacks in which every node is in the largest
+ * cluster is written for every percolation probability to <name>p<prob>.bin
+ * @return contents of the output file
+-------------------------------------------------------------------------------*/
+
+
+string ensemble_sweep(int num_nodes, float avg_degree, int threshold1, double frac_of_nodes_thresh1,
+		      int threshold2, int num_batches, uint64_t seed, int num_threads,
+		      const string &survival_name = "")
+{
+  // Build ER network
+  Flat_graph netA;
+  er_network(num_nodes, avg_degree, seed, netA, num_threads);
+
+
+  // Set local kcore thresholds for nodes
+  set_init_threshold_frac(netA, threshold1, frac_of_nodes_thresh1, threshold2, 1.0 - frac_of_nodes_thresh1,
+			  seed, num_threads);
+
+
+  // Every thread reads the whole network: huge pages, spread over the NUMA nodes
+  place_graph(netA, Memory_placement(pages_huge, nodes_interleave));
+
+
+  int num_attacks = num_batches * num_bitpar_lanes;
+
+  // Giant component fraction of every attack, in attack order
+  vector<double> Giant_comp_frac(num_attacks);
+
+
+  // Number of attacks in which every node is in the largest cluster
+  Survival_counter survival(survival_name.empty() ? 0 : num_nodes);
+
+  ostringstream output;
+
+
+  // Set the step size for percolation prob increment
+  double delta_perco_prob = 0.005;
+  long step = 0;
+
+
+  // Loop for different percolation probabilities
+  for (double percolation_prob = 1.00 ; percolation_prob >= (1.0/avg_degree); percolation_prob -= delta_perco_prob, ++step)
+    {
+
+      vector<double> lane_prob(num_bitpar_lanes, percolation_prob);
+
+      parallel_for(num_batches, num_threads, [&](int batch) {
+
+	  // Alive mask of every node, one bit per attack, and biggest cluster size of every attack
+	  vector<uint64_t> alive;
+	  vector<long> biggest_size;
+
+	  // Mask of the attacks in which every node is in the biggest cluster
+	  vector<uint64_t> in_biggest;
+
+	  // 64 random attacks, kcore pruning and biggest clusters together
+	  bitpar_random_attack(lane_prob, netA, alive, seed, uint64_t(step) * num_attacks + batch * num_bitpar_lanes, 1);
+	  bitpar_network_prune(netA, alive);
+	  bitpar_find_biggest_clusters(netA, alive, biggest_size, survival_name.empty() ? 0 : &in_biggest);
+
+	  if (!survival_name.empty()) survival.add(in_biggest);
+
+	  for (int lane = 0; lane < num_bitpar_lanes; ++lane)
+	    Giant_comp_frac[batch * num_bitpar_lanes + lane] = double(biggest_size[lane]) / double(num_nodes);
+	});
+
+      double mean_GC, sd_GC;
+      ensemble_mean_sd(Giant_comp_frac, mean_GC, sd_GC);
+
+
+      // Output average and standard deviation of the giant component fraction
+      output << 1.0 - percolation_prob << "  " << mean_GC << "  " << sd_GC << endl;
+
+
+      // Output survival counts of this percolation probability
+      if (!survival_name.empty()) {
+	ostringstream ostr_prob;
+	ostr_prob << percolation_prob;
+	survival.write(survival_name + "p" + ostr_prob.str() + ".bin", netA);
+	survival.clear();
+      }
+
+    }
+
+  return output.str();
+}
+
+
+/*-------------------------------------------------------------------------------
+ * Main function: Executes the following steps
+ * Builds a single network with poissonian degree distribution
+ * For every percolation probability, attacks num_batches*64 copies of the network,
+ * finds the largest kcore cluster of every copy and averages
+ * With the argument verify, runs with 1, 4 and all hardware threads and compares
+ * Returns int Exit code, 1 if the outputs of a verification differ
+ -------------------------------------------------------------------------------*/
+
+
+int main(int argc, char *argv[]){
+
+
+  // Initialize the random number generator
+  initsrand(1);
+
+
+  // Number of nodes in each network
+  const int num_nodes = 1000000;
+
+
+  // Number of batches of 64 attacks for every percolation probability
+  const int num_batches = 4;
+
+
+  // Number of threads, 0 for all hardware threads
+  const int num_threads = 0;
+
+
+  // Write the survival counts of every node for every percolation probability
+  const bool survival_output = false;
+
+
+  // Worker threads pinned to cpus in the order of their NUMA nodes
+  set_thread_pinning(true);
+
+
+  // Average degree for each network
+  float avg_degree = 10.0;
+
+  // kcore threshold values randomly chosen from
+  int threshold1, threshold2;
+
+
+  // Declare fraction of nodes set to have threshold1
+  double frac_of_nodes_thresh1;
+
+
+  // Read parameters for the network from a input file
+  cin >> threshold1;
+  cin >> frac_of_nodes_thresh1;
+  cin >> threshold2;
+
+
+  // Seed of the random number streams
+  uint64_t seed = uint64_t(srand() * 4294967296.0);
+
+
+  // Output file
+  ofstream output_file;
+  string file_name;
+
+
+  // Convert Parameter values to string for output filename
+
+  ostringstream ostr_num_nodes;
+  ostr_num_nodes << double(num_nodes);
+
+  ostringstream ostr_frac_thresh1;
+  ostr_frac_thresh1 << frac_of_nodes_thresh1;
+
+  ostringstream ostr_thresh1, ostr_thresh2;
+  ostr_thresh1 << threshold1;
+  ostr_thresh2 << threshold2;
+
+  ostringstream ostr_avg_degree;
+  ostr_avg_degree << avg_degree;
+
+  ostringstream ostr_num_attacks;
+  ostr_num_attacks << num_batches * num_bitpar_lanes;
+
+  file_name="./data/GCvsprob_ens"+ ostr_num_attacks.str()+"Nn"+ ostr_num_nodes.str()+"avgdeg_"+ ostr_avg_degree.str() +"L1_"+ ostr_thresh1.str()+"r_"+ ostr_frac_thresh1.str()+"L2_"+ ostr_thresh2.str()+".dat";
+
+  string survival_name;
+  if (survival_output)
+    survival_name="./data/Survival_ens"+ ostr_num_attacks.str()+"Nn"+ ostr_num_nodes.str()+"avgdeg_"+ ostr_avg_degree.str() +"L1_"+ ostr_thresh1.str()+"r_"+ ostr_frac_thresh1.str()+"L2_"+ ostr_thresh2.str();
+
+
+  // Output run parameters to screen
+  cout << "Number of nodes in the network  = " << num_nodes  << endl;
+  cout << "\n Average degree of nodes in the network is " << avg_degree << endl;
+  cout << "\n kcore thresholds are: " <<  threshold1 << "  " << threshold2 << endl;
+  cout << "fraction of nodes with threshold1 is " << frac_of_nodes_thresh1 << endl;
+  cout << "attacks per percolation probability: " << num_batches * num_bitpar_lanes << endl;
+  cout << "data is written to " << file_name.c_str() << endl;
+  if (survival_output) cout << "survival counts are written to " << survival_name.c_str() << "p*.bin" << endl;
+
+
+  /*-------------------------------------------------------------------------------
+   * Verification: the same job with different numbers of threads
+  -------------------------------------------------------------------------------*/
+
+
+  if (argc > 1 && string(argv[1]) == "verify") {
+
+    int thread_counts[3] = {1, 4, int(thread::hardware_concurrency())};
+    string reference;
+    bool all_same = true;
+
+    for (int t = 0; t < 3; ++t) {
+      string output = ensemble_sweep(num_nodes, avg_degree, threshold1, frac_of_nodes_thresh1, threshold2,
+				     num_batches, seed, thread_counts[t]);
+      if (t == 0) reference = output;
+
+      bool same = (output == reference);
+      all_same = all_same && same;
+      cout << " threads " << thread_counts[t] << ": " << (same ? "identical" : "DIFFERENT") << endl;
+    }
+
+    output_file.open(file_name.c_str());
+    output_file << reference;
+    output_file.close();
+
+    return all_same ? 0 : 1;
+  }
+
+
+  /*-------------------------------------------------------------------------------
+   * Simulates percolation process
+  -------------------------------------------------------------------------------*/
+
+
+  output_file.open(file_name.c_str());
+  output_file << ensemble_sweep(num_nodes, avg_degree, threshold1, frac_of_nodes_thresh1, threshold2,
+				num_batches, seed, num_threads, survival_name);
+  output_file.close();
+
+
+  return 0;
+}
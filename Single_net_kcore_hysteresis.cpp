@@ -0,0 +1,211 @@
+/*-------------------------------------------------------------------------------
+ * Simulates the hysteresis loop of k-core percolation on single network
+ * Calcualtes biggest cluster size as a function of percolation probability while
+ * nodes are removed in one random order, then while they are added back in reverse
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+using namespace std;
+#include <iostream>
+
+#include <fstream>
+#include <set>
+
+#include <string>
+#include <sstream>
+
+
+// Random number generator
+#include "./statool/srand.hpp"
+
+
+// Node and graph data structures
+#include "node.hpp"
+#include "graph.hpp"
+
+
+// Network building algorithm file
+#include "net_algo.hpp"
+
+
+// Percolation process functions on the flat snapshot of the network
+#include "net_ops_flat.hpp"
+
+
+// Random order of all nodes
+#include "net_sweep.hpp"
+
+
+// Removal and recovery branches of the hysteresis loop
+#include "net_recovery.hpp"
+
+
+// Early exit and lazy biggest cluster search
+#include "net_lazy.hpp"
+
+
+/*-------------------------------------------------------------------------------
+ * Main function: Executes the following steps
+ * Builds a single network with poissonian degree distribution
+ * Removes the nodes of a random order from p = 1 downwards, pruning every step
+ * Adds the nodes back from the lowest p upwards, activating nodes with enough neighbors
+ * Finds the largest kcore cluster of both branches
+ * Returns int Exit code
+ -------------------------------------------------------------------------------*/
+
+
+int main(){
+
+
+  // Initialize the random number generator
+  initsrand(1);
+
+
+  // Number of nodes in each network
+  const int num_nodes = 1000000;
+
+
+  // Average degree for each network
+  float avg_degree = 10.0;
+
+  // kcore threshold values randomly chosen from
+  int threshold1, threshold2;
+
+
+  // Declare fraction of nodes set to have threshold1
+  double frac_of_nodes_thresh1;
+
+
+  // Read parameters for the network from a input file
+  cin >> threshold1;
+  cin >> frac_of_nodes_thresh1;
+  cin >> threshold2;
+
+
+  // Output file
+  ofstream output_file;
+  string file_name;
+
+
+  // Convert Parameter values to string for output filename
+
+  ostringstream ostr_num_nodes;
+  ostr_num_nodes << double(num_nodes);
+
+  ostringstream ostr_frac_thresh1;
+  ostr_frac_thresh1 << frac_of_nodes_thresh1;
+
+  ostringstream ostr_thresh1, ostr_thresh2;
+  ostr_thresh1 << threshold1;
+  ostr_thresh2 << threshold2;
+
+  ostringstream ostr_avg_degree;
+  ostr_avg_degree << avg_degree;
+
+  file_name="./data/GCvsprob_hystNn"+ ostr_num_nodes.str()+"avgdeg_"+ ostr_avg_degree.str() +"L1_"+ ostr_thresh1.str()+"r_"+ ostr_frac_thresh1.str()+"L2_"+ ostr_thresh2.str()+".dat";
+
+
+  // Output run parameters to screen
+  cout << "Number of nodes in the network  = " << num_nodes  << endl;
+  cout << "\n Average degree of nodes in the network is " << avg_degree << endl;
+  cout << "\n kcore thresholds are: " <<  threshold1 << "  " << threshold2 << endl;
+  cout << "fraction of nodes with threshold1 is " << frac_of_nodes_thresh1 << endl;
+  cout << "data is written to " << file_name.c_str() << endl;
+
+
+  /*-------------------------------------------------------------------------------
+   * Build network and initialize
+   -------------------------------------------------------------------------------*/
+
+
+  // Create the network
+  Graph netA_initial(num_nodes);
+
+  // Build ER network
+  lt_ER_algo(netA_initial,avg_degree);
+
+
+  // Set local kcore thresholds for nodes
+  set_init_threshold_frac(netA_initial, threshold1, frac_of_nodes_thresh1, threshold2, 1.0 - frac_of_nodes_thresh1);
+
+
+  // Flat snapshot used by the simulation
+  Flat_graph netA(netA_initial);
+
+
+  // Nodes present at percolation probability p are the first num_present_nodes(p) of the order
+  vector<int> order;
+  random_node_order(netA, order);
+
+
+  // Percolation probabilities of both branches
+  double delta_perco_prob = 0.005;
+  vector<double> perco_probs;
+  for (double percolation_prob = 1.00 ; percolation_prob >= (1.0/avg_degree); percolation_prob -= delta_perco_prob)
+    perco_probs.push_back(percolation_prob);
+
+  int num_steps = perco_probs.size();
+  vector<double> GC_removal(num_steps), GC_recovery(num_steps);
+  vector<int> prune_iterations(num_steps);
+
+
+  /*-------------------------------------------------------------------------------
+   * Removal branch: every step removes the next nodes and prunes from the last state
+  -------------------------------------------------------------------------------*/
+
+
+  vector<int> live_degree;
+  reset_live_degree(netA, live_degree);
+  network_prune(netA, live_degree);
+
+  int num_present = num_nodes;
+
+  // Shortcuts of the biggest cluster search, removed nodes of different steps are nested
+  Lazy_sweep lazy_sweep(true);
+
+  for (int step = 0; step < num_steps; ++step) {
+
+    // No live node left: removal only takes away removed nodes and prunes in one scan
+    if (lazy_sweep.collapsed()) {
+      num_present = num_present_nodes(perco_probs[step], num_nodes);
+      prune_iterations[step] = 1;
+      GC_removal[step] = 1.0/double(num_nodes);
+      lazy_sweep.skip_steps(1);
+      continue;
+    }
+
+    prune_iterations[step] = removal_step(netA, order, num_present, num_present_nodes(perco_probs[step], num_nodes), live_degree);
+
+    GC_removal[step] = double(lazy_sweep.biggest_cluster_size(netA, live_degree))/double(num_nodes);
+  }
+
+
+  /*-------------------------------------------------------------------------------
+   * Recovery branch: from the last state nodes are added back in reverse
+  -------------------------------------------------------------------------------*/
+
+
+  Kcore_recovery recovery(netA, order, num_present, live_degree);
+
+  for (int step = num_steps - 1; step >= 0; --step) {
+
+    recovery.add_nodes(netA, order, num_present_nodes(perco_probs[step], num_nodes));
+    GC_recovery[step] = double(recovery.get_biggest_size())/double(num_nodes);
+  }
+
+
+  // Output result to file
+  output_file.open(file_name.c_str());
+
+  for (int step = 0; step < num_steps; ++step)
+    output_file << 1.0 - perco_probs[step] << "  " << GC_removal[step] << "  " << GC_recovery[step] << "  " << prune_iterations[step] << endl;
+
+  output_file.close();
+
+
+  // Work done and skipped by the shortcuts of the removal branch
+  lazy_sweep.report(cout);
+
+
+  return 0;
+}
@@ -31,6 +31,30 @@ using namespace std;
 #include "net_ops.hpp"
 
 
+// Percolation process functions on the flat snapshot of the network
+#include "net_ops_flat.hpp"
+
+
+// Attack and prune kernels specialized for the thresholds of the network
+#include "net_kernels.hpp"
+
+
+// Node orderings for memory locality
+#include "net_reorder.hpp"
+
+
+// Newman-Ziff sweep for thresholds up to 1
+#include "net_sweep.hpp"
+
+
+// Generating function theory of the giant kcore component
+#include "net_theory.hpp"
+
+
+// Early exit and lazy biggest cluster search
+#include "net_lazy.hpp"
+
+
 /*-------------------------------------------------------------------------------
  * Main function: Executes the following steps
  * Simulates a kcore percolation in a single network
@@ -55,6 +79,22 @@ int main(){
   
   // Average degree for each network
   float avg_degree = 10.0;  
+
+
+  // Relabeling of nodes for memory locality (order_none, order_bfs, order_rcm, order_degree)
+  // Output does not depend on the choice
+  const Node_order node_order = order_none;
+
+
+  // Percolation probabilities from the theory: fine steps around the predicted transition
+  // and coarse steps elsewhere, instead of uniform steps
+  const bool theory_grid = false;
+
+
+  // Stops the sweep after this many steps in a row without live nodes below the predicted
+  // transition, the remaining steps are not written, 0 to simulate every step
+  // Attacks of different steps are independent, so the stop is not exact
+  const int collapse_steps = 0;
   
   // kcore threshold values randomly chosen from
   int threshold1, threshold2;
@@ -72,10 +112,6 @@ int main(){
   double percolation_prob;
 
   
-  // Vector stoing node indices in largest cluster
-  vector<int> cluster_big;
-
-  
   // Fractional size of giant component ( biggest cluster)
   double Giant_comp_frac;
  
@@ -86,9 +122,9 @@ int main(){
   cin >> threshold2;
 
   
-  // Output file
+  // Output file, and file of the theoretical curve
   ofstream output_file;
-  string file_name;
+  string file_name, theory_file_name;
 
 
   // Convert Parameter values to string for output filename
@@ -107,6 +143,8 @@ int main(){
   ostr_avg_degree << avg_degree;
   
   file_name="./data/GCvsprobNn"+ ostr_num_nodes.str()+"avgdeg_"+ ostr_avg_degree.str() +"L1_"+ ostr_thresh2.str()+"r_"+ ostr_frac_thresh1.str()+"L2_"+ ostr_thresh2.str()+".dat";
+
+  theory_file_name="./data/GCvsprob_theory_avgdeg_"+ ostr_avg_degree.str() +"L1_"+ ostr_thresh1.str()+"r_"+ ostr_frac_thresh1.str()+"L2_"+ ostr_thresh2.str()+".dat";
   
   
   // Output run parameters to screen
@@ -115,6 +153,7 @@ int main(){
   cout << "\n kcore thresholds are: " <<  threshold1 << "  " << threshold2 << endl;
   cout << "fraction of nodes with threshold1 is " << frac_of_nodes_thresh1 << endl; 
   cout << "data is written to " << file_name.c_str() << endl;
+  cout << "theory is written to " << theory_file_name.c_str() << endl;
 
   
   /*-------------------------------------------------------------------------------
@@ -122,10 +161,7 @@ int main(){
    -------------------------------------------------------------------------------*/
 
   
-  // Create two networks 
-  Graph netA(num_nodes); 
-
-  // Create two backup networks
+  // Create the backup network
   Graph netA_initial(num_nodes); 
 
   // Build two ER networks
@@ -136,6 +172,47 @@ int main(){
   set_init_threshold_frac(netA_initial, threshold1, frac_of_nodes_thresh1, threshold2, 1.0 - frac_of_nodes_thresh1); 
 
 
+  // Flat snapshot of the backup network used by the simulation
+  Flat_graph netA(netA_initial);
+  reorder_nodes(netA, node_order);
+
+
+  // Thresholds of the network, used to choose the attack and prune kernel
+  Threshold_alphabet netA_thresholds(netA);
+
+
+  // Live degree of every node, the state of the network during a run
+  vector<int> live_degree;
+
+
+  // Thresholds up to 1 prune no node: ordinary percolation, where one sweep adding nodes
+  // in random order gives the biggest cluster for every percolation probability
+  // The attacks are nested instead of independent for every probability
+  bool ordinary_percolation = netA_thresholds.prunes_no_node();
+  vector<int> sweep_order;
+  vector<long> sweep_biggest;
+
+  if (ordinary_percolation) {
+    random_node_order(netA, sweep_order);
+    occupation_sweep(netA, sweep_order, sweep_biggest);
+  }
+
+
+
+  /*-------------------------------------------------------------------------------
+   * Theory of the infinite network: giant component curve and transition
+  -------------------------------------------------------------------------------*/
+
+
+  Kcore_theory theory(avg_degree, threshold1, frac_of_nodes_thresh1, threshold2);
+  double critical_prob = theory.critical_prob();
+  cout << "\n predicted transition at percolation probability " << critical_prob << endl;
+
+  ofstream theory_file(theory_file_name.c_str());
+  for (percolation_prob = 1.00 ; percolation_prob >= (1.0/avg_degree); percolation_prob -= 0.001)
+    theory_file << 1.0 - percolation_prob << "  " << theory.giant_component(percolation_prob) << endl;
+  theory_file.close();
+
 
   /*-------------------------------------------------------------------------------
    * Simulates percolation process
@@ -150,26 +227,60 @@ int main(){
   double delta_perco_prob = 0.005; 
 
 
+  // Percolation probabilities of the simulation
+  vector<double> perco_probs;
+
+  if (theory_grid)
+    theory.prob_grid(1.00, 1.0/avg_degree, 10 * delta_perco_prob, delta_perco_prob / 5, 0.02, perco_probs);
+  else
+    for(percolation_prob = 1.00 ; percolation_prob >= (1.0/avg_degree); percolation_prob -= delta_perco_prob)
+      perco_probs.push_back(percolation_prob);
+
+
+  // Biggest cluster search with shortcuts, attacks of different steps are independent
+  Lazy_sweep lazy_sweep(false);
+
+
   // Loop for different percolation probabilities
-  for(percolation_prob = 1.00 ; percolation_prob >= (1.0/avg_degree); percolation_prob -= delta_perco_prob)
+  for (size_t step = 0; step < perco_probs.size(); ++step)
     {
 
+      percolation_prob = perco_probs[step];
+
+      // Biggest cluster of the sweep, pruning takes a single scan
+      if (ordinary_percolation) {
+	Giant_comp_frac = double(sweep_biggest[num_present_nodes(percolation_prob, num_nodes)])/double(num_nodes);
+	output_file << 1.0 - percolation_prob <<"  "<< Giant_comp_frac  << "  " << 1 << endl;
+	continue;
+      }
+
+
+      // The kcore has collapsed: no live nodes in the last steps, below the predicted transition
+      if (collapse_steps > 0 && lazy_sweep.get_num_empty_in_row() >= collapse_steps && percolation_prob < critical_prob) {
+	cout << "\n sweep stopped at percolation probability " << percolation_prob << " after " << collapse_steps
+	     << " steps without kcore, the remaining steps are not written" << endl;
+	lazy_sweep.skip_steps(perco_probs.size() - step);
+	break;
+      }
+
       
       // Use Backup network to initialize the network to run simulation for new percolation_prob
-      netA = netA_initial;  
+      reset_live_degree(netA, live_degree);
 
     
-      // Remove randomly chosen nodes from both networks
-      initial_random_attack(percolation_prob, netA);
-   
+      // Remove randomly chosen nodes, then remove nodes with degree less than the local threshold to satisfy the kcore condition
+      num_of_prune_iterations = attack_and_prune(percolation_prob, netA, live_degree, netA_thresholds);
 
-      // Remove nodes with degree less than the local threshold to satisfy the kcore condition
-      num_of_prune_iterations = network_prune(netA);
+
+      // Verification sweep: no node may be left with degree less than its local threshold
+      if (count_prune_violations(live_degree.data(), netA.threshold_data(), num_nodes) != 0) {
+	cerr << "pruning left nodes below their kcore threshold!" << endl;
+	exit(1);
+      }
  
 
-      // Find the biggest cluster
-      find_biggest_cluster(netA, cluster_big);
-      Giant_comp_frac = double(cluster_big.size())/double(num_nodes);
+      // Find the biggest cluster size
+      Giant_comp_frac = double(lazy_sweep.biggest_cluster_size(netA, live_degree))/double(num_nodes);
 
       
       // Output result to file
@@ -180,6 +291,10 @@ int main(){
   
   // close the output file stream
   output_file.close();
+
+
+  // Work done and skipped by the shortcuts
+  if (!ordinary_percolation) lazy_sweep.report(cout);
  
   
   return 0;
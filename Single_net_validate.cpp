@@ -0,0 +1,866 @@
+/*-------------------------------------------------------------------------------
+ * Differential validation of the percolation engines against the list based functions
+ * Builds random networks and threshold assignments, runs initial_random_attack,
+ * network_prune and find_biggest_cluster of net_ops.hpp as the reference and every
+ * other engine with the same random numbers, and compares kcores, biggest clusters
+ * and prune scan or generation counts
+ * The library interface kcore_api.h is called from C (Single_net_validate_api.c) and
+ * its sweeps are compared with the same sweeps on the functions of the drivers
+ * Without arguments a fixed number of cases is run, with a number of seconds as
+ * argument cases are run until the time is used up (stress mode)
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+using namespace std;
+#include <iostream>
+
+#include <fstream>
+#include <set>
+
+#include <string>
+#include <sstream>
+
+#include <chrono>
+
+#include <stdlib.h>
+
+
+// Random number generator
+#include "./statool/srand.hpp"
+
+
+// Node and graph data structures
+#include "node.hpp"
+#include "graph.hpp"
+
+
+// Network building algorithm file
+#include "net_algo.hpp"
+
+
+// Percolation process functions, the reference
+#include "net_ops.hpp"
+
+
+// Engines under test
+#include "net_arena.hpp"
+#include "net_ops_flat.hpp"
+#include "net_kernels.hpp"
+#include "net_reorder.hpp"
+#include "net_bitpar.hpp"
+#include "net_parallel.hpp"
+#include "net_cores.hpp"
+#include "net_sweep.hpp"
+#include "net_avalanche.hpp"
+#include "net_bond.hpp"
+#include "net_recovery.hpp"
+#include "net_lazy.hpp"
+#include "net_compressed.hpp"
+#include "net_config_model.hpp"
+#include "net_deterministic.hpp"
+
+
+// Library interface, sweeps run by its C caller in Single_net_validate_api.c
+#include "kcore_api.h"
+
+extern "C" int validate_api_sweep(int num_nodes, double avg_degree, const int seed[4], int threshold1,
+				  double prob_thresh1, int threshold2, const double *probs, int num_probs,
+				  double *gc, int *scans);
+
+
+/*-------------------------------------------------------------------------------
+ * State of the random number generator, restored before every engine so all
+ * engines draw the same random numbers
+-------------------------------------------------------------------------------*/
+
+
+struct Srand_state {
+
+  int i, j, k, n;
+
+  void save() { i = iir; j = jjr; k = kkr; n = nnr; }
+  void restore() { iir = i; jjr = j; kkr = k; nnr = n; }
+};
+
+
+/*-------------------------------------------------------------------------------
+ * Parameters of one validation case, drawn at random
+-------------------------------------------------------------------------------*/
+
+
+struct Validation_case {
+
+  int num_nodes;
+  float avg_degree;
+  int threshold1, threshold2;
+  double frac_thresh1;
+
+  // Every third_every-th node gets threshold3, none if 0
+  int third_every, threshold3;
+
+  double percolation_prob;
+
+  void draw();
+  void print(ostream &out);
+};
+
+
+/*-------------------------------------------------------------------------------
+ * Mostly small networks, one in ten up to 1e5 nodes, thresholds 0 to 6
+-------------------------------------------------------------------------------*/
+
+
+void Validation_case::draw()
+{
+  num_nodes = srand() < 0.1 ? 10000 + int(srand() * 90000) : 20 + int(srand() * 2000);
+
+  avg_degree = 0.5 + srand() * 11.5;
+  if (avg_degree > (num_nodes - 1) / 2.0) avg_degree = (num_nodes - 1) / 2.0;
+
+  threshold1 = int(srand() * 7);
+  threshold2 = int(srand() * 7);
+  frac_thresh1 = srand() < 0.3 ? 1.0 : srand();
+
+  third_every = srand() < 0.2 ? 2 + int(srand() * 10) : 0;
+  threshold3 = int(srand() * 7);
+
+  percolation_prob = 0.2 + 0.8 * srand();
+}
+
+
+void Validation_case::print(ostream &out)
+{
+  out << "nodes " << num_nodes << " avg degree " << avg_degree << " thresholds " << threshold1
+      << "," << frac_thresh1 << "," << threshold2;
+  if (third_every) out << " and " << threshold3 << " every " << third_every;
+  out << " p " << percolation_prob;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param true if the engine agrees with the reference
+ * @param name of the engine and of the compared quantity
+ * @param number of failures, increased on a failure
+-------------------------------------------------------------------------------*/
+
+
+void expect(bool agrees, const string &what, int &num_failures)
+{
+  if (agrees) return;
+  cerr << "  differs: " << what << endl;
+  ++num_failures;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param list based network with thresholds set
+ * @param percolation probability
+ * @param snapshot with the index types under test
+ * @param live degree of the snapshot, set to the kcore
+ * @param size of the biggest cluster, set
+ * Attack and specialized prune, the random number generator is set by the caller
+ * @return number of prune scans
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+int run_index_width(Graph &net_initial, double p, Flat_graph_t<Vertex, Offset> &net, vector<int> &degree, long &gc)
+{
+  net.build_from(net_initial);
+  Threshold_alphabet alphabet(net);
+
+  reset_live_degree(net, degree);
+  int scans = attack_and_prune(p, net, degree, alphabet);
+
+  vector<Vertex> cluster;
+  find_biggest_cluster(net, degree, cluster);
+  gc = cluster.size();
+
+  return scans;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param two graph snapshots, flat or compressed
+ * @Returns true if every node has the same neighbors and threshold in both
+-------------------------------------------------------------------------------*/
+
+
+template <class Graph_a, class Graph_b>
+bool same_links(Graph_a &net_a, Graph_b &net_b)
+{
+  long num_nodes = net_a.get_num_vertices();
+  if (num_nodes != long(net_b.get_num_vertices())) return false;
+
+  vector<long> block_a, block_b;
+
+  for (long i = 0; i < num_nodes; ++i) {
+
+    block_a.clear();
+    block_b.clear();
+    for (typename Graph_a::node_neighbor_iterator it = net_a.vertex_neighbor_begin(i); it != net_a.vertex_neighbor_end(i); ++it)
+      block_a.push_back(*it);
+    for (typename Graph_b::node_neighbor_iterator it = net_b.vertex_neighbor_begin(i); it != net_b.vertex_neighbor_end(i); ++it)
+      block_b.push_back(*it);
+
+    sort(block_a.begin(), block_a.end());
+    sort(block_b.begin(), block_b.end());
+
+    if (block_a != block_b || net_a.get_deg_vertex(i) != net_b.get_deg_vertex(i)
+	|| net_a.get_threshold(i) != net_b.get_threshold(i))
+      return false;
+  }
+
+  return true;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param parameters of the case
+ * Builds the network and runs the reference and every engine
+ * @return number of failed comparisons
+-------------------------------------------------------------------------------*/
+
+
+int run_case(Validation_case &c)
+{
+  int num_failures = 0;
+  int num_nodes = c.num_nodes;
+  double p = c.percolation_prob;
+
+  Graph net_initial(num_nodes);
+  lt_ER_algo(net_initial, c.avg_degree);
+  set_init_threshold_frac(net_initial, c.threshold1, c.frac_thresh1, c.threshold2, 1.0 - c.frac_thresh1);
+  if (c.third_every)
+    for (int i = 0; i < num_nodes; i += c.third_every) net_initial.set_threshold(i, c.threshold3);
+
+  Srand_state attack_state;
+  attack_state.save();
+
+
+  // Reference: list based attack, prune and biggest cluster
+  Graph net_ref(num_nodes);
+  net_ref = net_initial;
+  initial_random_attack(p, net_ref);
+  int scans_ref = network_prune(net_ref);
+
+  vector<int> cluster_ref;
+  find_biggest_cluster(net_ref, cluster_ref);
+  long gc_ref = cluster_ref.size();
+
+  vector<int> degree_ref(num_nodes);
+  for (int i = 0; i < num_nodes; ++i) degree_ref[i] = net_ref.get_deg_vertex(i);
+
+
+  // List based network with arena storage
+  {
+    Arena arena;
+    Graph_t<Arena_allocator<int> > net(0, Arena_allocator<int>(&arena));
+    net.copy_from(net_initial);
+
+    attack_state.restore();
+    initial_random_attack(p, net);
+    int scans = network_prune(net);
+
+    vector<int> cluster;
+    find_biggest_cluster(net, cluster);
+
+    bool same_core = true;
+    for (int i = 0; i < num_nodes; ++i) same_core = same_core && net.get_deg_vertex(i) == degree_ref[i];
+
+    expect(same_core, "arena list network: kcore", num_failures);
+    expect(scans == scans_ref, "arena list network: prune scans", num_failures);
+    expect(long(cluster.size()) == gc_ref, "arena list network: biggest cluster", num_failures);
+
+
+    // Copy onto its own arena, copies into the copy leave the original intact
+    // Arena graphs have no copy constructor, a copy would share the arena
+    static_assert(!is_copy_constructible<Graph_t<Arena_allocator<int> > >::value, "arena graph copy constructor");
+    Arena arena_copy;
+    Graph_t<Arena_allocator<int> > net_copy(net, Arena_allocator<int>(&arena_copy));
+    expect(same_links(net_copy, net), "arena list network: copy", num_failures);
+
+    net_copy.copy_from(net_initial);
+    expect(same_links(net_copy, net_initial), "arena list network: copy_from into the copy", num_failures);
+    net_copy = net;
+    expect(same_links(net_copy, net), "arena list network: assignment to the copy", num_failures);
+
+    same_core = true;
+    for (int i = 0; i < num_nodes; ++i) same_core = same_core && net.get_deg_vertex(i) == degree_ref[i];
+    expect(same_core, "arena list network: original of the copy", num_failures);
+  }
+
+
+  // Flat snapshot: generic prune, specialized kernels
+  Flat_graph net(net_initial);
+  Threshold_alphabet alphabet(net);
+  vector<int> attacked, degree, cluster;
+
+  attack_state.restore();
+  reset_live_degree(net, attacked);
+  initial_random_attack(p, net, attacked);
+
+  degree = attacked;
+  int scans = network_prune(net, degree);
+  find_biggest_cluster(net, degree, cluster);
+
+  expect(degree == degree_ref, "flat network_prune: kcore", num_failures);
+  expect(scans == scans_ref, "flat network_prune: prune scans", num_failures);
+  expect(long(cluster.size()) == gc_ref, "flat network_prune: biggest cluster", num_failures);
+  expect(count_prune_violations(degree.data(), net.threshold_data(), num_nodes) == 0,
+	 "flat network_prune: verification sweep", num_failures);
+
+  attack_state.restore();
+  reset_live_degree(net, degree);
+  scans = attack_and_prune(p, net, degree, alphabet);
+
+  expect(degree == degree_ref, "specialized kernel: kcore", num_failures);
+  expect(scans == scans_ref, "specialized kernel: prune scans", num_failures);
+
+
+  // Compressed snapshots: made from the flat snapshot, and streamed from the links of the
+  // list network in ranges of about a third of the link ends
+  {
+    Compressed_graph net_compressed(net);
+
+    vector<int> link_ends;
+    for (int i = 0; i < num_nodes; ++i)
+      for (Graph::node_neighbor_iterator it = net_initial.vertex_neighbor_begin(i); it != net_initial.vertex_neighbor_end(i); ++it)
+	if (i < *it) {
+	  link_ends.push_back(i);
+	  link_ends.push_back(*it);
+	}
+
+    Compressed_graph net_streamed;
+    net_streamed.build_from_links(num_nodes, link_ends.size() / 2, link_ends.data(), link_ends.size() / 3 + 1);
+    for (int i = 0; i < num_nodes; ++i) net_streamed.set_threshold(i, net_initial.get_threshold(i));
+
+    expect(same_links(net_streamed, net), "streamed compressed snapshot: links", num_failures);
+
+    vector<int> degree_compressed, cluster_compressed;
+    attack_state.restore();
+    reset_live_degree(net_compressed, degree_compressed);
+    initial_random_attack(p, net_compressed, degree_compressed);
+    int scans_compressed = network_prune(net_compressed, degree_compressed);
+    find_biggest_cluster(net_compressed, degree_compressed, cluster_compressed);
+
+    expect(degree_compressed == degree_ref, "compressed snapshot: kcore", num_failures);
+    expect(scans_compressed == scans_ref, "compressed snapshot: prune scans", num_failures);
+    expect(long(cluster_compressed.size()) == gc_ref, "compressed snapshot: biggest cluster", num_failures);
+  }
+
+
+  // Network generators, flat and streamed compressed snapshots of the same network
+  {
+    const uint64_t seed = uint64_t(num_nodes) * 2654435761u;
+
+    vector<int> degree_sequence(num_nodes);
+    for (int i = 0; i < num_nodes; ++i) degree_sequence[i] = net.get_deg_vertex(i);
+    make_degree_sum_even(degree_sequence);
+
+    Flat_graph net_config;
+    Compressed_graph net_config_compressed;
+    long dropped = configuration_model(degree_sequence, seed, net_config, 2);
+    long dropped_compressed = configuration_model(degree_sequence, seed, net_config_compressed, 1, num_nodes);
+
+    expect(same_links(net_config_compressed, net_config), "compressed configuration model: links", num_failures);
+    expect(dropped_compressed == dropped, "compressed configuration model: dropped pairs", num_failures);
+
+    Flat_graph net_er;
+    Compressed_graph net_er_compressed;
+    long drawn_again = er_network(num_nodes, c.avg_degree, seed, net_er, 2);
+    long drawn_again_compressed = er_network(num_nodes, c.avg_degree, seed, net_er_compressed, 1, num_nodes);
+
+    expect(same_links(net_er_compressed, net_er), "compressed ER network: links", num_failures);
+    expect(drawn_again_compressed == drawn_again, "compressed ER network: links drawn again", num_failures);
+  }
+
+
+  // Snapshots with 32 bit offsets and with 64 bit node indices
+  {
+    vector<int> degree_width;
+    long gc_width;
+
+    Flat_graph_32 net_32;
+    attack_state.restore();
+    int scans_width = run_index_width(net_initial, p, net_32, degree_width, gc_width);
+
+    expect(degree_width == degree_ref, "32 bit snapshot: kcore", num_failures);
+    expect(scans_width == scans_ref, "32 bit snapshot: prune scans", num_failures);
+    expect(gc_width == gc_ref, "32 bit snapshot: biggest cluster", num_failures);
+
+    Flat_graph_64 net_64;
+    attack_state.restore();
+    scans_width = run_index_width(net_initial, p, net_64, degree_width, gc_width);
+
+    expect(degree_width == degree_ref, "64 bit snapshot: kcore", num_failures);
+    expect(scans_width == scans_ref, "64 bit snapshot: prune scans", num_failures);
+    expect(gc_width == gc_ref, "64 bit snapshot: biggest cluster", num_failures);
+  }
+
+
+  // Relabeled snapshots
+  Node_order orders[] = {order_bfs, order_rcm, order_degree};
+  const char *order_names[] = {"bfs", "rcm", "degree"};
+
+  for (int o = 0; o < 3; ++o) {
+
+    Flat_graph net_relabeled(net_initial);
+    reorder_nodes(net_relabeled, orders[o]);
+    Threshold_alphabet alphabet_relabeled(net_relabeled);
+
+    vector<int> degree_relabeled;
+    attack_state.restore();
+    reset_live_degree(net_relabeled, degree_relabeled);
+    int scans_relabeled = attack_and_prune(p, net_relabeled, degree_relabeled, alphabet_relabeled);
+
+    vector<int> cluster_relabeled;
+    find_biggest_cluster(net_relabeled, degree_relabeled, cluster_relabeled);
+
+    bool same_core = true;
+    for (int i = 0; i < num_nodes; ++i)
+      same_core = same_core && degree_relabeled[net_relabeled.get_label(i)] == degree_ref[i];
+
+    string name = string(order_names[o]) + " order: ";
+    expect(same_core, name + "kcore", num_failures);
+    expect(scans_relabeled == scans_ref, name + "prune scans", num_failures);
+    expect(long(cluster_relabeled.size()) == gc_ref, name + "biggest cluster", num_failures);
+  }
+
+
+  // Frontier engines, serial and with 3 threads
+  {
+    vector<int> degree_frontier = attacked, degree_parallel = attacked;
+    int generations = network_prune_frontier(net, degree_frontier);
+    int generations_parallel = network_prune_parallel(net, degree_parallel, 3);
+
+    expect(degree_frontier == degree_ref, "frontier engine: kcore", num_failures);
+    expect(degree_parallel == degree_ref, "multi-threaded frontier engine: kcore", num_failures);
+    expect(generations_parallel == generations, "multi-threaded frontier engine: generations", num_failures);
+  }
+
+
+  // Bit parallel engine, lane 0 draws the random numbers of the reference
+  {
+    vector<double> lane_prob(num_bitpar_lanes, p);
+    vector<uint64_t> alive;
+    vector<long> biggest_size;
+
+    attack_state.restore();
+    bitpar_random_attack(lane_prob, net, alive);
+    bitpar_network_prune(net, alive);
+    bitpar_find_biggest_clusters(net, alive, biggest_size);
+
+    // A node alive without alive neighbors has no live links, degree 0 in the reference
+    bool same_core = true;
+    for (int i = 0; i < num_nodes; ++i) {
+      bool linked = false;
+      if (alive[i] & 1)
+	for (Flat_graph::node_neighbor_iterator it = net.vertex_neighbor_begin(i); it != net.vertex_neighbor_end(i); ++it)
+	  linked = linked || (alive[*it] & 1);
+      same_core = same_core && linked == (degree_ref[i] > 0);
+    }
+
+    expect(same_core, "bit parallel engine: kcore", num_failures);
+    expect(biggest_size[0] == gc_ref, "bit parallel engine: biggest cluster", num_failures);
+  }
+
+
+  // Core decomposition for a uniform threshold
+  if (alphabet.get_num_values() == 1) {
+
+    int k = alphabet.get_low() > 0 ? alphabet.get_low() : 0;
+
+    vector<int> core;
+    vector<long> biggest_size;
+    core_numbers(net, attacked, core);
+    biggest_kcore_clusters(net, core, k, biggest_size);
+
+    bool same_core = true;
+    for (int i = 0; i < num_nodes; ++i)
+      same_core = same_core && (core[i] > 0 && core[i] >= k) == (degree_ref[i] > 0);
+
+    expect(same_core, "core numbers: kcore", num_failures);
+    expect(biggest_size[k] == gc_ref, "core numbers: biggest cluster", num_failures);
+  }
+
+
+  // Newman-Ziff sweep, checked against a network with the same nodes removed
+  if (alphabet.prunes_no_node()) {
+
+    vector<int> order;
+    vector<long> sweep_biggest;
+    random_node_order(net, order);
+    occupation_sweep(net, order, sweep_biggest);
+
+    int num_present = num_present_nodes(p, num_nodes);
+    vector<int> degree_sweep;
+    reset_live_degree(net, degree_sweep);
+    for (int n = num_present; n < num_nodes; ++n)
+      if (degree_sweep[order[n]]) rm_a_node(net, degree_sweep, order[n]);
+
+    vector<int> cluster_sweep;
+    find_biggest_cluster(net, degree_sweep, cluster_sweep);
+    expect(sweep_biggest[num_present] == long(cluster_sweep.size()), "Newman-Ziff sweep: biggest cluster", num_failures);
+  }
+
+
+  // Avalanche probes of up to 20 nodes, checked against removal and pruning of a copy
+  {
+    Avalanche_prober prober;
+    Threshold_array threshold(net.threshold_data());
+    vector<int> degree_probe;
+
+    int stride = num_nodes / 20 > 1 ? num_nodes / 20 : 1;
+    for (int node_idx = 0; node_idx < num_nodes; node_idx += stride) {
+
+      int depth;
+      long size = prober.probe(net, degree, threshold, node_idx, depth);
+
+      long size_copy = 0;
+      if (degree[node_idx] > 0) {
+	degree_probe = degree;
+	rm_a_node(net, degree_probe, node_idx);
+	network_prune(net, degree_probe);
+	for (int i = 0; i < num_nodes; ++i) size_copy += degree[i] > 0 && degree_probe[i] == 0;
+      }
+
+      expect(size == size_copy, "avalanche probe: size", num_failures);
+    }
+
+    expect(degree == degree_ref, "avalanche probe: undo", num_failures);
+  }
+
+  return num_failures;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param order in which nodes are present
+ * @param number of present nodes
+ * @param live degree, set to the kcore of the present nodes pruned from scratch
+-------------------------------------------------------------------------------*/
+
+
+void fresh_present_kcore(Flat_graph &net, const vector<int> &order, int num_present, vector<int> &degree)
+{
+  int num_nodes = net.get_num_vertices();
+
+  reset_live_degree(net, degree);
+  for (int n = num_present; n < num_nodes; ++n)
+    if (degree[order[n]]) rm_a_node(net, degree, order[n]);
+  network_prune(net, degree);
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param state of the recovery branch
+ * Active neighbors are counted from the active nodes, not taken from the state
+ * @Returns true if every active node is present and has threshold active neighbors,
+ * no present inactive node has, and the number of active nodes agrees
+-------------------------------------------------------------------------------*/
+
+
+bool consistent_recovery(Flat_graph &net, Kcore_recovery &recovery)
+{
+  int num_nodes = net.get_num_vertices();
+  long num_active = 0;
+
+  Flat_graph::node_neighbor_iterator it;
+
+  for (int v = 0; v < num_nodes; ++v) {
+
+    int num_active_neighbors = 0;
+    for (it = net.vertex_neighbor_begin(v); it != net.vertex_neighbor_end(v); ++it)
+      num_active_neighbors += recovery.is_active(*it);
+
+    bool reached = net.get_threshold(v) <= 1 || num_active_neighbors >= net.get_threshold(v);
+
+    if (recovery.is_active(v)) {
+      ++num_active;
+      if (!recovery.is_present(v) || !reached) return false;
+    }
+    else if (recovery.is_present(v) && reached) return false;
+  }
+
+  return num_active == recovery.get_num_active();
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param parameters of the case
+ * Nested sweeps from p = 1 down to the p of the case, the last step repeated, then p = 0,
+ * as the drivers run them: every incremental step is checked against a fresh prune of
+ * the same present links or nodes, and every shortcut of Lazy_sweep against the search
+ * The recovery branch is checked from the p of the case upwards: its biggest cluster
+ * is that of the kcore at the lowest p and never above it later, and its active nodes
+ * are exactly those the activation rule allows, their biggest cluster searched again
+ * The generator is restored afterwards, so the cases that follow do not change
+ * @return number of failed comparisons
+-------------------------------------------------------------------------------*/
+
+
+int run_sweep_case(Validation_case &c)
+{
+  int num_failures = 0;
+  int num_nodes = c.num_nodes;
+
+  Srand_state case_state;
+  case_state.save();
+
+  Graph net_initial(num_nodes);
+  lt_ER_algo(net_initial, c.avg_degree);
+  set_init_threshold_frac(net_initial, c.threshold1, c.frac_thresh1, c.threshold2, 1.0 - c.frac_thresh1);
+  if (c.third_every)
+    for (int i = 0; i < num_nodes; i += c.third_every) net_initial.set_threshold(i, c.threshold3);
+
+  Flat_graph net(net_initial);
+
+  vector<double> probs;
+  for (int s = 0; s <= 4; ++s) probs.push_back(1.0 - 0.25 * s * (1.0 - c.percolation_prob));
+  probs.push_back(c.percolation_prob);
+  probs.push_back(0.0);
+
+
+  // Bond percolation: incremental prune of the failed links against a network of the present links
+  {
+    Bond_links<> links(net);
+    links.random_order();
+
+    vector<int> degree, cluster, degree_fresh, cluster_fresh, link_ends;
+    vector<uint64_t> candidates;
+    links.reset(net, degree);
+
+    Lazy_sweep lazy_sweep(true);
+    long lazy_size;
+
+    const int *first = net.vertex_neighbor_begin(0);
+    Flat_graph::node_neighbor_iterator it;
+
+    for (size_t s = 0; s < probs.size(); ++s) {
+
+      links.fail_links(num_failed_links(probs[s], links.get_num_links()), net, degree, candidates);
+      if (s == 0) find_prune_candidates(degree.data(), net.threshold_data(), num_nodes, candidates);
+      bond_network_prune(net, links, degree, candidates);
+      bond_find_biggest_cluster(net, links, degree, cluster);
+
+      link_ends.clear();
+      for (int u = 0; u < num_nodes; ++u)
+	for (it = net.vertex_neighbor_begin(u); it != net.vertex_neighbor_end(u); ++it)
+	  if (u < *it && links.is_present(it - first)) {
+	    link_ends.push_back(u);
+	    link_ends.push_back(*it);
+	  }
+
+      Flat_graph net_fresh;
+      net_fresh.build_from_links(num_nodes, link_ends.size() / 2, link_ends.data());
+      for (int i = 0; i < num_nodes; ++i) net_fresh.set_threshold(i, net.get_threshold(i));
+
+      reset_live_degree(net_fresh, degree_fresh);
+      network_prune(net_fresh, degree_fresh);
+      find_biggest_cluster(net_fresh, degree_fresh, cluster_fresh);
+
+      expect(degree == degree_fresh, "incremental bond prune: kcore", num_failures);
+      expect(cluster.size() == cluster_fresh.size(), "incremental bond prune: biggest cluster", num_failures);
+
+      if (!lazy_sweep.size_known(degree, num_nodes, lazy_size)) {
+	lazy_size = cluster.size();
+	lazy_sweep.searched(lazy_size, lazy_sweep.get_num_live());
+      }
+      expect(lazy_size == long(cluster_fresh.size()), "lazy bond sweep: biggest cluster", num_failures);
+    }
+  }
+
+
+  // Node removal: removal step against a network with the same nodes removed and pruned
+  {
+    vector<int> order, degree, degree_fresh, cluster_fresh;
+    random_node_order(net, order);
+
+    Lazy_sweep lazy_sweep(true);
+
+    reset_live_degree(net, degree);
+    network_prune(net, degree);
+    int num_present = num_nodes;
+
+    for (size_t s = 0; s < probs.size(); ++s) {
+
+      removal_step(net, order, num_present, num_present_nodes(probs[s], num_nodes), degree);
+
+      fresh_present_kcore(net, order, num_present, degree_fresh);
+
+      expect(degree == degree_fresh, "removal step: kcore", num_failures);
+
+      find_biggest_cluster(net, degree_fresh, cluster_fresh);
+      long size_fresh = cluster_fresh.size();
+
+      Lazy_sweep lazy_single(false);
+      expect(lazy_sweep.biggest_cluster_size(net, degree) == size_fresh, "lazy sweep: biggest cluster", num_failures);
+      expect(lazy_single.biggest_cluster_size(net, degree_fresh) == size_fresh, "lazy search: biggest cluster",
+	     num_failures);
+    }
+
+    expect(lazy_sweep.collapsed(), "lazy sweep: collapse", num_failures);
+
+
+    // Recovery branch from the removal branch at the p of the case, nodes added back up to p = 1
+    int lowest = probs.size() - 2;
+
+    reset_live_degree(net, degree);
+    network_prune(net, degree);
+    num_present = num_nodes;
+    removal_step(net, order, num_present, num_present_nodes(probs[lowest], num_nodes), degree);
+
+    Kcore_recovery recovery(net, order, num_present, degree);
+
+    for (int s = lowest; s >= 0; --s) {
+
+      recovery.add_nodes(net, order, num_present_nodes(probs[s], num_nodes));
+
+      fresh_present_kcore(net, order, recovery.get_num_present(), degree_fresh);
+      find_biggest_cluster(net, degree_fresh, cluster_fresh);
+      long size_fresh = cluster_fresh.size();
+
+      if (s == lowest)
+	expect(recovery.get_biggest_size() == size_fresh, "recovery: biggest cluster at the lowest p", num_failures);
+      else
+	expect(recovery.get_biggest_size() <= size_fresh, "recovery: biggest cluster not above the removal branch",
+	       num_failures);
+      expect(consistent_recovery(net, recovery), "recovery: activation", num_failures);
+
+      for (int i = 0; i < num_nodes; ++i) degree_fresh[i] = recovery.is_active(i);
+      find_biggest_cluster(net, degree_fresh, cluster_fresh);
+      expect(recovery.get_biggest_size() == long(cluster_fresh.size()), "recovery: biggest cluster of the active nodes",
+	     num_failures);
+    }
+  }
+
+  case_state.restore();
+
+  return num_failures;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param parameters of the case, the third threshold is not used
+ * Draws the 4 integers of a seed.dat file, runs a sweep through the library from C and
+ * the same sweep as Single_net_kcore_perco.cpp started with that seed.dat
+ * The generator is restored afterwards, so the cases that follow do not change
+ * @return number of failed comparisons
+-------------------------------------------------------------------------------*/
+
+
+int run_api_case(Validation_case &c)
+{
+  int num_failures = 0;
+  int num_nodes = c.num_nodes;
+
+  Srand_state case_state;
+  case_state.save();
+
+  int seed[4];
+  for (int i = 0; i < 4; ++i) seed[i] = int(srand() * 2147483647.0);
+
+  vector<double> probs;
+  probs.push_back(1.0);
+  probs.push_back(c.percolation_prob);
+  probs.push_back(0.5 * (1.0 + c.percolation_prob));
+
+
+  // Driver: initsrand(1) reads the seeds and draws the seeds of the next run
+  iir = abs(seed[0]) + 1; jjr = abs(seed[1]) + 1; kkr = abs(seed[2]) + 1; nnr = seed[3];
+  for (int i = 0; i < 4; ++i) srand();
+
+  Graph net_initial(num_nodes);
+  lt_ER_algo(net_initial, c.avg_degree);
+  set_init_threshold_frac(net_initial, c.threshold1, c.frac_thresh1, c.threshold2, 1.0 - c.frac_thresh1);
+
+  Flat_graph net(net_initial);
+  Threshold_alphabet alphabet(net);
+
+  vector<double> gc_driver(probs.size());
+  vector<int> scans_driver(probs.size()), degree, cluster;
+
+  for (size_t i = 0; i < probs.size(); ++i) {
+    reset_live_degree(net, degree);
+    scans_driver[i] = attack_and_prune(probs[i], net, degree, alphabet);
+    find_biggest_cluster(net, degree, cluster);
+    gc_driver[i] = double(cluster.size())/double(num_nodes);
+  }
+
+
+  // Library from its C caller
+  vector<double> gc_api(probs.size());
+  vector<int> scans_api(probs.size());
+
+  int result = validate_api_sweep(num_nodes, c.avg_degree, seed, c.threshold1, c.frac_thresh1, c.threshold2,
+				  probs.data(), probs.size(), gc_api.data(), scans_api.data());
+
+  expect(result == KCORE_OK, "library from C: interface", num_failures);
+  expect(gc_api == gc_driver, "library from C: biggest cluster", num_failures);
+  expect(scans_api == scans_driver, "library from C: prune scans", num_failures);
+
+  case_state.restore();
+
+  return num_failures;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * Main function: runs validation cases
+ * Argument: time budget in seconds for stress mode, fixed number of cases otherwise
+ * Returns int Exit code, 1 if any engine differs from the reference
+ -------------------------------------------------------------------------------*/
+
+
+int main(int argc, char **argv){
+
+
+  // Initialize the random number generator, seeds are not updated so runs repeat
+  initsrand(0);
+
+
+  // Number of cases without a time budget
+  const int num_cases_default = 200;
+
+
+  // Time budget of stress mode in seconds, 0 for a fixed number of cases
+  double time_budget = argc > 1 ? atof(argv[1]) : 0.0;
+
+
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  int num_cases = 0, num_failed_cases = 0;
+
+  while (true) {
+
+    if (time_budget > 0) {
+      if (chrono::duration<double>(chrono::steady_clock::now() - start).count() > time_budget) break;
+    }
+    else if (num_cases == num_cases_default) break;
+
+    // Generator state is printed with a failure so the case can be run again
+    Srand_state case_state;
+    case_state.save();
+
+    Validation_case c;
+    c.draw();
+
+    int num_failures = run_case(c) + run_sweep_case(c) + run_api_case(c);
+    ++num_cases;
+
+    if (num_failures) {
+      ++num_failed_cases;
+      cerr << "case " << num_cases << " failed: ";
+      c.print(cerr);
+      cerr << "\n  generator state " << case_state.i << " " << case_state.j << " "
+	   << case_state.k << " " << case_state.n << endl;
+    }
+  }
+
+  cout << num_cases << " cases, " << num_failed_cases << " failed" << endl;
+
+
+  return num_failed_cases ? 1 : 0;
+}
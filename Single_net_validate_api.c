@@ -0,0 +1,71 @@
+/*-------------------------------------------------------------------------------
+ * C caller of the library interface kcore_api.h, part of the validation harness
+ * Compiled as C99, so the header is checked as a C program sees it, and linked into
+ * kcore_validate_exe with libkcore.so: Single_net_validate.cpp compares the sweep run
+ * here with the same sweep run on the functions the drivers use
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+
+#include <stdlib.h>
+
+#include "kcore_api.h"
+
+
+/*-------------------------------------------------------------------------------
+ * @param number of nodes and average degree of the network
+ * @param 4 integers of a seed.dat file
+ * @param kcore thresholds as in input_parameters
+ * @param percolation probabilities of the sweep and their number
+ * @param fraction of nodes in the biggest cluster and prune scans of every probability, set
+ * Builds the network through the library and runs a sweep, the nodes of the biggest
+ * cluster of the last probability are checked against its size and the live degree
+ * @return KCORE_OK, an error code of the library, or 1 if the library broke its interface
+-------------------------------------------------------------------------------*/
+
+
+int validate_api_sweep(int num_nodes, double avg_degree, const int seed[4], int threshold1, double prob_thresh1,
+		       int threshold2, const double *probs, int num_probs, double *gc, int *scans)
+{
+  kcore_network *net;
+  int *live_degree, *cluster;
+  size_t biggest_size, i;
+  int result;
+
+  if (kcore_api_version() != KCORE_API_VERSION) return 1;
+
+
+  // A network without nodes is invalid input
+  if (kcore_build_links(0, 0, NULL, seed)) return 1;
+
+
+  net = kcore_build_er(num_nodes, avg_degree, seed);
+  if (!net) return KCORE_ERROR_NO_MEMORY;
+
+  result = kcore_set_thresholds_frac(net, threshold1, prob_thresh1, threshold2);
+
+  live_degree = (int *) malloc(num_nodes * sizeof(int));
+  cluster = (int *) malloc(num_nodes * sizeof(int));
+
+  if (result == KCORE_OK && (!live_degree || !cluster)) result = KCORE_ERROR_NO_MEMORY;
+  if (result == KCORE_OK) result = kcore_sweep(net, probs, num_probs, live_degree, gc, scans);
+
+
+  // Biggest cluster of the last state: as many live nodes as the sweep counted
+  if (result == KCORE_OK && num_probs > 0) {
+
+    biggest_size = kcore_biggest_cluster(net, live_degree, cluster);
+
+    if (biggest_size == KCORE_SIZE_ERROR) result = KCORE_ERROR_NO_MEMORY;
+    else if ((double) biggest_size / num_nodes != gc[num_probs - 1]) result = 1;
+    else if (biggest_size > 1)
+      for (i = 0; i < biggest_size; ++i)
+	if (cluster[i] < 0 || cluster[i] >= num_nodes || live_degree[cluster[i]] <= 0) result = 1;
+  }
+
+  free(cluster);
+  free(live_degree);
+  kcore_free(net);
+
+  return result;
+}
@@ -0,0 +1,425 @@
+/*-------------------------------------------------------------------------------
+ * Contains Flat_graph class
+ * Flat_graph is a read-only snapshot of a Graph in compressed sparse row form
+ * Neighbor lists, degrees and kcore thresholds are stored in contiguous arrays
+ * Per-run state (live degree of every node) is kept outside the snapshot
+ * Nodes can be relabeled for memory locality, the labels are kept so results and
+ * random node choices can be given in the index of the network that was built
+ * Flat_graph_t is templated on the type of node indices (Vertex) and of offsets into
+ * the adjacency array (Offset), select_index_width picks the smallest types for a network
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+
+#ifndef FLAT_GRAPH_HPP
+#define FLAT_GRAPH_HPP
+
+
+/*-----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <algorithm>
+
+#include "graph.hpp"
+
+/*-----------------------------------------------------------------------------*/
+
+
+template <class Vertex = int, class Offset = long>
+class Flat_graph_t {
+
+protected:
+
+  // offsets[i] .. offsets[i+1] is the block of node i in the adjacency array
+  vector<Offset> offsets;
+
+
+  // Indices of neighbors of all the nodes stored one after another
+  vector<Vertex> adjacency;
+
+
+  // Degree of every node at the time the snapshot was taken
+  vector<int> degrees;
+
+
+  // Local kcore threshold of every node
+  vector<int> thresholds;
+
+
+  // Index in the snapshot of every node of the built network, empty if not relabeled
+  vector<Vertex> labels;
+
+
+  // Index in the built network of every node of the snapshot, inverse of labels
+  vector<Vertex> original_index;
+
+
+public:
+
+  typedef Vertex vertex_type;
+  typedef Offset offset_type;
+
+
+  // Copies links and thresholds of a list based graph
+  template <class Alloc> void build_from(Graph_t<Alloc> &net);
+
+
+  // Takes over neighbor blocks built elsewhere, thresholds set to 0
+  void build_from_adjacency(vector<Offset> &offsets_inp, vector<Vertex> &adjacency_inp);
+
+
+  // Links given as pairs of end nodes, thresholds set to 0
+  void build_from_links(Vertex num_nodes, size_t num_links, const Vertex *link_ends);
+
+
+  // Moves every node i to index new_label[i]
+  void relabel(const vector<Vertex> &new_label);
+
+
+  // Conversion between index in the built network and index in the snapshot
+  bool is_relabeled() { return !labels.empty(); }
+  Vertex get_label(Vertex original_idx) { return labels.empty() ? original_idx : labels[original_idx]; }
+  Vertex get_original_index(Vertex idx_vertex) { return original_index.empty() ? idx_vertex : original_index[idx_vertex]; }
+  const Vertex * label_data() { return labels.data(); }
+  const Vertex * original_index_data() { return original_index.data(); }
+
+
+  // Returns the size of the network
+  Vertex size();
+  Vertex get_num_vertices();
+  Offset get_num_edges();
+
+
+  // Bytes held by the snapshot, and by the neighbor blocks with their offsets only
+  size_t memory_bytes();
+  size_t adjacency_bytes() { return offsets.size() * sizeof(Offset) + adjacency.size() * sizeof(Vertex); }
+
+
+  // Calls f(data, bytes) for every array, used to place the snapshot in memory (net_placement.hpp)
+  template <class Function> void visit_arrays(Function f) {
+    f(offsets.data(), offsets.size() * sizeof(Offset));
+    f(adjacency.data(), adjacency.size() * sizeof(Vertex));
+    f(degrees.data(), degrees.size() * sizeof(int));
+    f(thresholds.data(), thresholds.size() * sizeof(int));
+    f(labels.data(), labels.size() * sizeof(Vertex));
+    f(original_index.data(), original_index.size() * sizeof(Vertex));
+  }
+
+
+  // Single node functions
+  int get_deg_vertex(Vertex idx_vertex);
+  int get_threshold(Vertex idx_vertex);
+  void set_threshold(Vertex idx_vertex, int threshold_inp);
+
+
+  // Contiguous arrays used by the vectorized kernels
+  const int * threshold_data() { return thresholds.data(); }
+  const vector<int> & initial_degrees() { return degrees; }
+
+
+  // iterator functions
+  typedef const Vertex * node_neighbor_iterator;
+  node_neighbor_iterator vertex_neighbor_begin(size_t index) {
+    return adjacency.data() + offsets[index]; }
+  node_neighbor_iterator vertex_neighbor_end(size_t index) {
+    return adjacency.data() + offsets[index+1]; }
+
+
+  // Constructors
+  Flat_graph_t() {
+    offsets.assign(1, 0);
+  }
+
+  template <class Alloc>
+  Flat_graph_t(Graph_t<Alloc> &net) {
+    build_from(net);
+  }
+};
+
+
+// Snapshot with the index types of the list based graph, used by all engines
+typedef Flat_graph_t<> Flat_graph;
+
+
+// Compact and wide snapshots for networks built directly as snapshots
+typedef Flat_graph_t<uint32_t, uint32_t> Flat_graph_32;
+typedef Flat_graph_t<uint32_t, uint64_t> Flat_graph_32_64;
+typedef Flat_graph_t<uint64_t, uint64_t> Flat_graph_64;
+
+
+// Index types of a snapshot, from the smallest
+enum Index_width { index_32, index_32_64, index_64 };
+
+//------------------------------Member function definitions----------------------
+/*-------------------------------------------------------------------------------
+ * @param list based graph object
+ * Copies the neighbor lists and the local thresholds of every node
+ * Neighbor order of every node is kept so traversals visit nodes in the same order
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+template <class Alloc>
+inline void Flat_graph_t<Vertex, Offset>::build_from(Graph_t<Alloc> &net)
+{
+  int num_nodes = net.get_num_vertices();
+
+  offsets.resize(num_nodes + 1);
+  degrees.resize(num_nodes);
+  thresholds.resize(num_nodes);
+
+  // Count the links first so the adjacency array is allocated only once
+  offsets[0] = 0;
+  for (int i = 0; i < num_nodes; ++i) {
+    degrees[i] = net.get_deg_vertex(i);
+    thresholds[i] = net.get_threshold(i);
+    offsets[i+1] = offsets[i] + degrees[i];
+  }
+
+  adjacency.resize(offsets[num_nodes]);
+
+  typename Graph_t<Alloc>::node_neighbor_iterator it;
+  for (int i = 0; i < num_nodes; ++i) {
+    Offset pos = offsets[i];
+    for (it = net.vertex_neighbor_begin(i); it != net.vertex_neighbor_end(i); ++it)
+      adjacency[pos++] = *it;
+  }
+
+  labels.clear();
+  original_index.clear();
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param offsets of the neighbor block of every node, num_nodes + 1 entries
+ * @param neighbors of all nodes, every link in the blocks of both its end nodes
+ * The input vectors are swapped into the snapshot and left empty
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+inline void Flat_graph_t<Vertex, Offset>::build_from_adjacency(vector<Offset> &offsets_inp, vector<Vertex> &adjacency_inp)
+{
+  offsets.swap(offsets_inp);
+  adjacency.swap(adjacency_inp);
+  offsets_inp.clear();
+  adjacency_inp.clear();
+
+  Vertex num_nodes = offsets.size() - 1;
+
+  degrees.resize(num_nodes);
+  for (Vertex i = 0; i < num_nodes; ++i) degrees[i] = offsets[i+1] - offsets[i];
+
+  thresholds.assign(num_nodes, 0);
+
+  labels.clear();
+  original_index.clear();
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param number of nodes
+ * @param number of links
+ * @param end nodes of every link one after another, 2 * num_links entries
+ * Self-loops are dropped and multiple links kept once, neighbor blocks are sorted
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+inline void Flat_graph_t<Vertex, Offset>::build_from_links(Vertex num_nodes, size_t num_links, const Vertex *link_ends)
+{
+  vector<Offset> new_offsets(num_nodes + 1, 0);
+  for (size_t e = 0; e < num_links; ++e)
+    if (link_ends[2*e] != link_ends[2*e+1]) {
+      ++new_offsets[link_ends[2*e] + 1];
+      ++new_offsets[link_ends[2*e+1] + 1];
+    }
+  for (Vertex i = 0; i < num_nodes; ++i) new_offsets[i+1] += new_offsets[i];
+
+  vector<Vertex> new_adjacency(new_offsets[num_nodes]);
+  vector<Offset> fill(new_offsets.begin(), new_offsets.end() - 1);
+  for (size_t e = 0; e < num_links; ++e) {
+    Vertex u = link_ends[2*e], v = link_ends[2*e+1];
+    if (u == v) continue;
+    new_adjacency[fill[u]++] = v;
+    new_adjacency[fill[v]++] = u;
+  }
+
+  // Sort every block and close the gaps left by multiple links
+  Offset pos = 0;
+  for (Vertex i = 0; i < num_nodes; ++i) {
+    typename vector<Vertex>::iterator first = new_adjacency.begin() + new_offsets[i];
+    typename vector<Vertex>::iterator last = new_adjacency.begin() + new_offsets[i+1];
+    sort(first, last);
+    last = unique(first, last);
+    if (pos != new_offsets[i]) copy(first, last, new_adjacency.begin() + pos);
+    new_offsets[i] = pos;
+    pos += last - first;
+  }
+  new_offsets[num_nodes] = pos;
+  new_adjacency.resize(pos);
+
+  build_from_adjacency(new_offsets, new_adjacency);
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param vector with the new index of every node, a permutation
+ * Moves the links, degree and threshold of every node to its new index
+ * Neighbor blocks are sorted so neighbors are read in increasing memory order
+ * Labels of earlier relabelings are combined, so get_label always refers to the built network
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+inline void Flat_graph_t<Vertex, Offset>::relabel(const vector<Vertex> &new_label)
+{
+  Vertex num_nodes = size();
+
+  vector<Offset> new_offsets(num_nodes + 1);
+  vector<Vertex> new_adjacency(adjacency.size());
+  vector<int> new_degrees(num_nodes), new_thresholds(num_nodes);
+
+  vector<Vertex> old_index(num_nodes);
+  for (Vertex i = 0; i < num_nodes; ++i) old_index[new_label[i]] = i;
+
+  new_offsets[0] = 0;
+  for (Vertex v = 0; v < num_nodes; ++v) {
+
+    Vertex i = old_index[v];
+    new_degrees[v] = degrees[i];
+    new_thresholds[v] = thresholds[i];
+    new_offsets[v+1] = new_offsets[v] + degrees[i];
+
+    Offset pos = new_offsets[v];
+    for (Offset e = offsets[i]; e < offsets[i+1]; ++e)
+      new_adjacency[pos++] = new_label[adjacency[e]];
+    sort(new_adjacency.begin() + new_offsets[v], new_adjacency.begin() + new_offsets[v+1]);
+  }
+
+  offsets.swap(new_offsets);
+  adjacency.swap(new_adjacency);
+  degrees.swap(new_degrees);
+  thresholds.swap(new_thresholds);
+
+  // Combine with an earlier relabeling
+  if (labels.empty()) labels = new_label;
+  else for (Vertex i = 0; i < num_nodes; ++i) labels[i] = new_label[labels[i]];
+
+  original_index.resize(num_nodes);
+  for (Vertex i = 0; i < num_nodes; ++i) original_index[labels[i]] = i;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @Returns the number of nodes in the graph
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+inline Vertex Flat_graph_t<Vertex, Offset>::size()
+{
+  return degrees.size();
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @Returns the number of nodes in the graph
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+inline Vertex Flat_graph_t<Vertex, Offset>::get_num_vertices()
+{
+  return degrees.size();
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @Returns the number of links in the graph
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+inline Offset Flat_graph_t<Vertex, Offset>::get_num_edges()
+{
+  return offsets.back() / 2;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @Returns the number of bytes of the arrays of the snapshot
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+inline size_t Flat_graph_t<Vertex, Offset>::memory_bytes()
+{
+  return offsets.size() * sizeof(Offset) + adjacency.size() * sizeof(Vertex)
+    + (degrees.size() + thresholds.size()) * sizeof(int)
+    + (labels.size() + original_index.size()) * sizeof(Vertex);
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param integer index of the node
+ * @Returns degree of the input node when the snapshot was taken
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+inline int Flat_graph_t<Vertex, Offset>::get_deg_vertex(Vertex idx_vertex)
+{
+  return degrees[idx_vertex];
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param integer index of the node
+ * @Returns local kcore threshold value for the input node
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+inline int Flat_graph_t<Vertex, Offset>::get_threshold(Vertex idx_vertex)
+{
+  return thresholds[idx_vertex];
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param integer index of the node
+ * @param integer threshold value for local kcore threshold
+ * Updates the local threshold value of the input node to input threshold value
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+inline void Flat_graph_t<Vertex, Offset>::set_threshold(Vertex idx_vertex, int threshold_inp)
+{
+  thresholds[idx_vertex] = threshold_inp;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param number of nodes
+ * @param number of link ends, twice the number of links
+ * @Returns the smallest index types of a snapshot of the network
+ * 32 bit offsets while the link ends fit, 64 bit node indices above 2^32 - 1 nodes
+-------------------------------------------------------------------------------*/
+
+
+inline Index_width select_index_width(uint64_t num_nodes, uint64_t num_link_ends)
+{
+  const uint64_t max_32 = 0xffffffffULL;
+
+  if (num_nodes < max_32 && num_link_ends <= max_32) return index_32;
+  if (num_nodes < max_32) return index_32_64;
+  return index_64;
+}
+
+
+#endif
@@ -2,6 +2,7 @@
  * Contains graph class 
  * Contains graph functions
  * Graph is a vector of node objects
+ * Graph_t<Alloc> places the neighbor lists with Alloc, Graph uses the heap
  * @Author: Nagendra Panduranga
 -------------------------------------------------------------------------------*/
 
@@ -16,15 +17,67 @@
 
 #include <list>
 
+#include <type_traits>
+
+#include <utility>
+
 #include "node.hpp"
 
+/*-------------------------------------------------------------------------------
+ * Called by Graph_t::copy_from once all lists of a graph are destroyed,
+ * with the allocator of the graph and of the graph to be copied
+ * Heap lists need nothing, an arena allocator overloads it to drop its memory at once
+-------------------------------------------------------------------------------*/
+
+
+template <class Alloc, class Other_alloc>
+inline void release_list_storage(Alloc &, const Other_alloc &) {}
+
+
+/*-------------------------------------------------------------------------------
+ * Used by Graph_t::operator= and the copy constructor, true_type if list elements
+ * freed one by one can be used again
+ * An arena allocator overloads it with false_type, its memory is only reused after a reset
+-------------------------------------------------------------------------------*/
+
+
+template <class Alloc>
+inline true_type reuses_freed_lists(const Alloc &) { return true_type(); }
+
+
+/*-------------------------------------------------------------------------------
+ * Base of Graph_t, without a copy constructor when the lists are not reused:
+ * a copy would share the arena of the original and reset it in its next copy_from
+ * Such graphs are copied with the constructor that takes an allocator
+-------------------------------------------------------------------------------*/
+
+
+template <bool copyable>
+class Graph_copy_base {};
+
+
+template <>
+class Graph_copy_base<false> {
+
+public:
+
+  Graph_copy_base() {}
+  Graph_copy_base(const Graph_copy_base &) = delete;
+  Graph_copy_base & operator=(const Graph_copy_base &) { return *this; }
+};
+
 /*-----------------------------------------------------------------------------*/
 
-class Graph {
+template <class Alloc = allocator<int> >
+class Graph_t : public Graph_copy_base<decltype(reuses_freed_lists(declval<const Alloc &>()))::value> {
   
 protected:
 
-  vector<Node> vertices;
+  vector<Node_t<Alloc> > vertices;
+
+
+  // Allocator given to the lists of every node
+  Alloc node_alloc;
   
 public:
 
@@ -37,6 +90,26 @@ public:
   int get_num_vertices();
   void resize(int num_nodes);
 
+
+  // Copies all nodes of another graph into the lists of this graph
+  template <class Other_alloc> void copy_from(const Graph_t<Other_alloc> &other);
+
+
+  // Assignment keeps the allocator of this graph, heap lists are reused where possible,
+  // lists of an arena are copied with copy_from so the arena is reset and does not grow
+  Graph_t & operator=(const Graph_t &other);
+
+
+  // Copy constructor of heap graphs, deleted for arena graphs (Graph_copy_base),
+  // those are copied onto their own arena with the allocator given
+  Graph_t(const Graph_t &other) = default;
+  template <class Other_alloc> Graph_t(const Graph_t<Other_alloc> &other, const Alloc &alloc)
+    : node_alloc(alloc) { copy_from(other); }
+
+
+  // graphs with other allocators are copied from
+  template <class Other_alloc> friend class Graph_t;
+
   
   //check if node1 and node2 are connected or not
   bool connection_check(int node1,int node2);
@@ -65,7 +138,7 @@ public:
 
   
   //iterator functions
-  typedef list<int>::iterator node_neighbor_iterator;
+  typedef typename Node_t<Alloc>::neighbor_iterator node_neighbor_iterator;
   node_neighbor_iterator vertex_neighbor_begin(size_t index) { 
     return vertices[index].neighbor_begin(); }
   node_neighbor_iterator vertex_neighbor_end(size_t index) { 
@@ -73,11 +146,16 @@ public:
 
   
   // Constructor
-  Graph(int num_nd) {
-    vertices.resize(num_nd);
+  Graph_t(int num_nd, const Alloc &alloc = Alloc()) : node_alloc(alloc) {
+    vertices.resize(num_nd, Node_t<Alloc>(node_alloc));
   }
 };
 
+
+// Graph with lists on the heap
+typedef Graph_t<> Graph;
+
+
 //------------------------------Member function definitions----------------------
 /*-------------------------------------------------------------------------------
  * @param two integer indices for two nodes
@@ -86,7 +164,8 @@ public:
 -------------------------------------------------------------------------------*/
 
 
-void Graph::insert_connection(int n1,int n2) {
+template <class Alloc>
+void Graph_t<Alloc>::insert_connection(int n1,int n2) {
   vertices[n1].add_a_neighbor(n2);
   vertices[n2].add_a_neighbor(n1);
 }
@@ -99,7 +178,8 @@ void Graph::insert_connection(int n1,int n2) {
 -------------------------------------------------------------------------------*/
 
 
-void Graph::rm_a_node(int node_idx)
+template <class Alloc>
+void Graph_t<Alloc>::rm_a_node(int node_idx)
 {
   node_neighbor_iterator it;
   for(it=vertex_neighbor_begin(node_idx);it!=vertex_neighbor_end(node_idx);++it){
@@ -116,7 +196,8 @@ void Graph::rm_a_node(int node_idx)
 -------------------------------------------------------------------------------*/
 
 
-void Graph::show_neighbors(int node_idx,vector<int> &v)
+template <class Alloc>
+void Graph_t<Alloc>::show_neighbors(int node_idx,vector<int> &v)
 {
   node_neighbor_iterator it; 
   for(it=vertex_neighbor_begin(node_idx);it!=vertex_neighbor_end(node_idx);++it){
@@ -133,7 +214,8 @@ void Graph::show_neighbors(int node_idx,vector<int> &v)
 -------------------------------------------------------------------------------*/
 
 
-int Graph::get_deg_vertex(int idx_vertex)
+template <class Alloc>
+int Graph_t<Alloc>::get_deg_vertex(int idx_vertex)
 {
   return vertices[idx_vertex].get_degree();
 }
@@ -144,7 +226,8 @@ int Graph::get_deg_vertex(int idx_vertex)
 -------------------------------------------------------------------------------*/
 
 
-int Graph::size()
+template <class Alloc>
+int Graph_t<Alloc>::size()
 {
   return vertices.size();
 }
@@ -155,7 +238,8 @@ int Graph::size()
 -------------------------------------------------------------------------------*/
 
 
-int Graph::get_num_vertices(){
+template <class Alloc>
+int Graph_t<Alloc>::get_num_vertices(){
   return vertices.size();
 }
 
@@ -166,7 +250,8 @@ int Graph::get_num_vertices(){
 -------------------------------------------------------------------------------*/
 
 
-bool Graph::connection_check(int node1,int node2)
+template <class Alloc>
+bool Graph_t<Alloc>::connection_check(int node1,int node2)
 {
   node_neighbor_iterator it;
   for(it=vertex_neighbor_begin(node1);it!=vertex_neighbor_end(node1);++it)
@@ -182,9 +267,50 @@ bool Graph::connection_check(int node1,int node2)
 -------------------------------------------------------------------------------*/
 
 
-void Graph::resize(int num_nodes)
+template <class Alloc>
+void Graph_t<Alloc>::resize(int num_nodes)
+{
+  vertices.resize(num_nodes, Node_t<Alloc>(node_alloc));
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph object to be copied, with any allocator
+ * Destroys all lists of this graph, releases their storage, and copies every node
+ * of the other graph into new lists built with the allocator of this graph
+ * With an arena allocator the copy fills one contiguous block and nothing is freed one by one
+-------------------------------------------------------------------------------*/
+
+
+template <class Alloc>
+template <class Other_alloc>
+void Graph_t<Alloc>::copy_from(const Graph_t<Other_alloc> &other)
+{
+  vertices.clear();
+  release_list_storage(node_alloc, other.node_alloc);
+
+  vertices.reserve(other.vertices.size());
+  for (size_t i = 0; i < other.vertices.size(); ++i)
+    vertices.push_back(Node_t<Alloc>(other.vertices[i], node_alloc));
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph object to be copied, with the same allocator type
+ * Heap lists are assigned node by node and reuse their elements, arena lists are
+ * copied with copy_from, which resets the arena first
+-------------------------------------------------------------------------------*/
+
+
+template <class Alloc>
+Graph_t<Alloc> & Graph_t<Alloc>::operator=(const Graph_t<Alloc> &other)
 {
-  vertices.resize(num_nodes);
+  if (this == &other) return *this;
+
+  if (reuses_freed_lists(node_alloc)) vertices = other.vertices;
+  else copy_from(other);
+
+  return *this;
 }
 
 
@@ -195,7 +321,8 @@ void Graph::resize(int num_nodes)
 -------------------------------------------------------------------------------*/
 
 
-void Graph::set_threshold(int idx_vertex, int threshold_inp)
+template <class Alloc>
+void Graph_t<Alloc>::set_threshold(int idx_vertex, int threshold_inp)
 {
   vertices[idx_vertex].set_threshold(threshold_inp);
 }
@@ -207,7 +334,8 @@ void Graph::set_threshold(int idx_vertex, int threshold_inp)
 -------------------------------------------------------------------------------*/
 
 
-int Graph::get_threshold(int idx_vertex)
+template <class Alloc>
+int Graph_t<Alloc>::get_threshold(int idx_vertex)
 {
   return vertices[idx_vertex].get_threshold();
 }
@@ -219,7 +347,8 @@ int Graph::get_threshold(int idx_vertex)
 -------------------------------------------------------------------------------*/
 
 
-void Graph::set_dependence(int idx_vertex,int dependence_value)
+template <class Alloc>
+void Graph_t<Alloc>::set_dependence(int idx_vertex,int dependence_value)
 {
   vertices[idx_vertex].set_dependence(dependence_value);
 }
@@ -232,7 +361,8 @@ void Graph::set_dependence(int idx_vertex,int dependence_value)
 -------------------------------------------------------------------------------*/
 
 
-int Graph::get_dependence(int idx_vertex)
+template <class Alloc>
+int Graph_t<Alloc>::get_dependence(int idx_vertex)
 {
   return vertices[idx_vertex].get_dependence();
 }
@@ -244,7 +374,8 @@ int Graph::get_dependence(int idx_vertex)
 -------------------------------------------------------------------------------*/
 
 
-void Graph::add_a_dependant(int n1,int n2)
+template <class Alloc>
+void Graph_t<Alloc>::add_a_dependant(int n1,int n2)
 {
   vertices[n1].add_a_dependant(n2);
 }
@@ -256,7 +387,8 @@ void Graph::add_a_dependant(int n1,int n2)
 -------------------------------------------------------------------------------*/
 
 
-void Graph::protect_node(int node_idx)
+template <class Alloc>
+void Graph_t<Alloc>::protect_node(int node_idx)
 {
   vertices[node_idx].protect_node();
 }
@@ -268,7 +400,8 @@ void Graph::protect_node(int node_idx)
 -------------------------------------------------------------------------------*/
 
 
-void Graph::unprotect_node(int node_idx)
+template <class Alloc>
+void Graph_t<Alloc>::unprotect_node(int node_idx)
 {
   vertices[node_idx].unprotect_node();
 }
@@ -280,7 +413,8 @@ void Graph::unprotect_node(int node_idx)
 -------------------------------------------------------------------------------*/
 
 
-void Graph::unprotect_allnodes()
+template <class Alloc>
+void Graph_t<Alloc>::unprotect_allnodes()
 {
   for(int i=0;i<vertices.size();++i)
     vertices[i].unprotect_node();
@@ -293,7 +427,8 @@ void Graph::unprotect_allnodes()
 -------------------------------------------------------------------------------*/
 
 
-bool Graph::protect_check(int node_idx)
+template <class Alloc>
+bool Graph_t<Alloc>::protect_check(int node_idx)
 {
   return vertices[node_idx].protect_check();
 }
@@ -0,0 +1,382 @@
+/*-------------------------------------------------------------------------------
+ * Library implementation of kcore_api.h on the header files of the simulation
+ * Compiled on its own into a shared library:
+ *   C++ -O2 -pthread -fPIC -shared -fvisibility=hidden kcore_api.cpp -o libkcore.so
+ * Only the functions of kcore_api.h are exported, srand() and the templates stay
+ * inside the library and cannot clash with a program that includes the headers itself
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+using namespace std;
+#include <iostream>
+
+#include <set>
+
+#include <vector>
+
+#include <mutex>
+
+#include <new>
+
+#include <stdlib.h>
+
+
+// Random number generator
+#include "./statool/srand.hpp"
+
+
+// Node and graph data structures
+#include "node.hpp"
+#include "graph.hpp"
+
+
+// Network building algorithm file
+#include "net_algo.hpp"
+
+
+// Percolation process functions on the flat snapshot of the network
+#include "net_ops_flat.hpp"
+
+
+// Attack and prune kernels specialized for the thresholds of the network
+#include "net_kernels.hpp"
+
+
+// Configuration model network building
+#include "net_config_model.hpp"
+
+
+#include "kcore_api.h"
+
+
+/*-------------------------------------------------------------------------------
+ * Network of the library: snapshot, thresholds and the state of srand() of the network
+-------------------------------------------------------------------------------*/
+
+
+struct kcore_network {
+
+  Flat_graph net;
+  Threshold_alphabet alphabet;
+
+  int seed_state[4];
+
+  // Seeds written to seed.dat by initsrand(1) when the network was made
+  int next_seed[4];
+};
+
+
+// srand() keeps one state, networks take turns to use it
+static mutex srand_mutex;
+
+
+/*-------------------------------------------------------------------------------
+ * Holds srand() for one network while it draws random numbers, the state of the
+ * network is loaded on construction and stored back on destruction
+-------------------------------------------------------------------------------*/
+
+
+class Srand_lock {
+
+protected:
+
+  lock_guard<mutex> lock;
+  kcore_network *knet;
+
+public:
+
+  Srand_lock(kcore_network *knet_inp) : lock(srand_mutex), knet(knet_inp) {
+    iir = knet->seed_state[0]; jjr = knet->seed_state[1]; kkr = knet->seed_state[2]; nnr = knet->seed_state[3];
+  }
+
+  ~Srand_lock() {
+    knet->seed_state[0] = iir; knet->seed_state[1] = jjr; knet->seed_state[2] = kkr; knet->seed_state[3] = nnr;
+  }
+};
+
+
+/*-------------------------------------------------------------------------------
+ * @param 4 integers of a seed.dat file
+ * @Returns a network with the generator seeded as initsrand(1) does
+ * initsrand(1) draws the seeds of the next run first, so they are drawn here too
+-------------------------------------------------------------------------------*/
+
+
+static kcore_network * new_network(const int seed[4])
+{
+  kcore_network *knet = new kcore_network;
+
+  knet->seed_state[0] = abs(seed[0]) + 1;
+  knet->seed_state[1] = abs(seed[1]) + 1;
+  knet->seed_state[2] = abs(seed[2]) + 1;
+  knet->seed_state[3] = seed[3];
+
+  Srand_lock lock(knet);
+  for (int i = 0; i < 4; ++i)
+    knet->next_seed[i] = abs(static_cast<int>((srand() - 0.5e0) / 0.23283064e-9));
+
+  return knet;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * Called in the catch block of an exported function, no exception leaves the library
+ * @Returns the error code of the exception being handled
+-------------------------------------------------------------------------------*/
+
+
+static int current_error_code()
+{
+  try {
+    throw;
+  }
+  catch (const bad_alloc &) {
+    return KCORE_ERROR_NO_MEMORY;
+  }
+  catch (...) {
+    return KCORE_ERROR_INTERNAL;
+  }
+}
+
+
+//------------------------------Building----------------------------------------
+
+
+int kcore_api_version(void)
+{
+  return KCORE_API_VERSION;
+}
+
+
+kcore_network * kcore_build_er(int num_nodes, double avg_degree, const int seed[4])
+{
+  // lt_ER_algo needs the number of links to fit in the network
+  if (num_nodes < 1 || avg_degree < 0.0 || avg_degree > num_nodes - 1) return 0;
+
+  kcore_network *knet = 0;
+
+  try {
+    knet = new_network(seed);
+
+    Graph net_initial(num_nodes);
+    {
+      Srand_lock lock(knet);
+      lt_ER_algo(net_initial, float(avg_degree));
+    }
+    knet->net.build_from(net_initial);
+    knet->alphabet.build_from(knet->net);
+  }
+  catch (...) {
+    delete knet;
+    return 0;
+  }
+
+  return knet;
+}
+
+
+kcore_network * kcore_build_links(int num_nodes, size_t num_links, const int *link_ends, const int seed[4])
+{
+  if (num_nodes < 1 || (num_links && !link_ends)) return 0;
+
+  for (size_t e = 0; e < 2 * num_links; ++e)
+    if (link_ends[e] < 0 || link_ends[e] >= num_nodes) return 0;
+
+  kcore_network *knet = 0;
+
+  try {
+    knet = new_network(seed);
+
+    knet->net.build_from_links(num_nodes, num_links, link_ends);
+    knet->alphabet.build_from(knet->net);
+  }
+  catch (...) {
+    delete knet;
+    return 0;
+  }
+
+  return knet;
+}
+
+
+kcore_network * kcore_build_config(int num_nodes, const int *degree, const int seed[4], int num_threads)
+{
+  if (num_nodes < 1 || !degree) return 0;
+
+  for (int i = 0; i < num_nodes; ++i)
+    if (degree[i] < 0) return 0;
+
+  kcore_network *knet = 0;
+
+  try {
+    knet = new_network(seed);
+
+    vector<int> degree_even(degree, degree + num_nodes);
+    make_degree_sum_even(degree_even);
+
+    // Seed of the network drawn as in Single_net_kcore_config.cpp
+    uint64_t network_seed;
+    {
+      Srand_lock lock(knet);
+      network_seed = uint64_t(srand() * 4294967296.0);
+    }
+
+    configuration_model(degree_even, network_seed, knet->net, num_threads);
+    knet->alphabet.build_from(knet->net);
+  }
+  catch (...) {
+    delete knet;
+    return 0;
+  }
+
+  return knet;
+}
+
+
+void kcore_free(kcore_network *knet)
+{
+  delete knet;
+}
+
+
+//------------------------------Properties and thresholds----------------------
+
+
+int kcore_num_nodes(const kcore_network *knet)
+{
+  return const_cast<kcore_network *>(knet)->net.get_num_vertices();
+}
+
+
+size_t kcore_num_links(const kcore_network *knet)
+{
+  return const_cast<kcore_network *>(knet)->net.get_num_edges();
+}
+
+
+void kcore_get_seed(const kcore_network *knet, int seed[4])
+{
+  for (int i = 0; i < 4; ++i) seed[i] = knet->next_seed[i];
+}
+
+
+int kcore_set_thresholds(kcore_network *knet, const int *threshold)
+{
+  try {
+    int num_nodes = knet->net.get_num_vertices();
+    for (int i = 0; i < num_nodes; ++i) knet->net.set_threshold(i, threshold[i]);
+
+    knet->alphabet.build_from(knet->net);
+  }
+  catch (...) {
+    return current_error_code();
+  }
+
+  return KCORE_OK;
+}
+
+
+int kcore_set_thresholds_frac(kcore_network *knet, int threshold1, double prob_thresh1, int threshold2)
+{
+  try {
+    {
+      Srand_lock lock(knet);
+      set_init_threshold_frac(knet->net, threshold1, prob_thresh1, threshold2, 1.0 - prob_thresh1);
+    }
+
+    knet->alphabet.build_from(knet->net);
+  }
+  catch (...) {
+    return current_error_code();
+  }
+
+  return KCORE_OK;
+}
+
+
+//------------------------------Runs on arrays of the caller-------------------
+
+
+void kcore_reset(kcore_network *knet, int *live_degree)
+{
+  Degree_buffer degree(live_degree, knet->net.get_num_vertices());
+  reset_live_degree(knet->net, degree);
+}
+
+
+int kcore_attack(kcore_network *knet, double p, int *live_degree)
+{
+  try {
+    Degree_buffer degree(live_degree, knet->net.get_num_vertices());
+
+    Srand_lock lock(knet);
+    initial_random_attack(p, knet->net, degree);
+  }
+  catch (...) {
+    return current_error_code();
+  }
+
+  return KCORE_OK;
+}
+
+
+int kcore_prune(kcore_network *knet, int *live_degree)
+{
+  try {
+    Degree_buffer degree(live_degree, knet->net.get_num_vertices());
+    return network_prune(knet->net, degree, knet->alphabet);
+  }
+  catch (...) {
+    return current_error_code();
+  }
+}
+
+
+int kcore_attack_and_prune(kcore_network *knet, double p, int *live_degree)
+{
+  int result = kcore_attack(knet, p, live_degree);
+  if (result < 0) return result;
+
+  return kcore_prune(knet, live_degree);
+}
+
+
+size_t kcore_biggest_cluster(kcore_network *knet, const int *live_degree, int *cluster)
+{
+  try {
+    Degree_buffer degree(const_cast<int *>(live_degree), knet->net.get_num_vertices());
+
+    // Nodes are written to the array of the caller as they are found
+    return find_biggest_cluster(knet->net, degree, cluster);
+  }
+  catch (...) {
+    return KCORE_SIZE_ERROR;
+  }
+}
+
+
+int kcore_sweep(kcore_network *knet, const double *probs, int num_probs, int *live_degree, double *gc, int *scans)
+{
+  try {
+    int num_nodes = knet->net.get_num_vertices();
+    Degree_buffer degree(live_degree, num_nodes);
+
+    for (int i = 0; i < num_probs; ++i) {
+
+      reset_live_degree(knet->net, degree);
+      {
+	Srand_lock lock(knet);
+	initial_random_attack(probs[i], knet->net, degree);
+      }
+      int num_of_prune_iterations = network_prune(knet->net, degree, knet->alphabet);
+
+      gc[i] = double(find_biggest_cluster(knet->net, degree, (int *) 0)) / double(num_nodes);
+      if (scans) scans[i] = num_of_prune_iterations;
+    }
+  }
+  catch (...) {
+    return current_error_code();
+  }
+
+  return KCORE_OK;
+}
@@ -0,0 +1,226 @@
+/*-------------------------------------------------------------------------------
+ * Library interface of the k-core percolation simulation, usable from C and C++
+ * A network is built once and kept in the library, runs work on arrays owned by the
+ * caller: the live degree of every node (the state of a run, a removed node has degree 0),
+ * the nodes of the biggest cluster and the results of a sweep
+ * Random numbers are drawn as in the drivers, every network keeps its own generator
+ * state, so a network seeded with the numbers of seed.dat gives the same network and
+ * attacks as a driver started with that seed.dat
+ * Functions on different networks can be called from different threads at once
+ * Build: C++ -O2 -pthread -fPIC -shared -fvisibility=hidden kcore_api.cpp -o libkcore.so
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+
+#ifndef KCORE_API_H
+#define KCORE_API_H
+
+
+/*-----------------------------------------------------------------------------*/
+
+#include <stddef.h>
+
+/*-----------------------------------------------------------------------------*/
+
+
+// Incremented when a function is added, existing functions keep their meaning
+// Version 2: functions that allocate return an error code instead of nothing
+#define KCORE_API_VERSION 2
+
+
+// Error codes, no exception leaves the library
+#define KCORE_OK 0
+#define KCORE_ERROR_NO_MEMORY (-1)
+#define KCORE_ERROR_INTERNAL (-2)
+
+
+// Returned by kcore_biggest_cluster on an error
+#define KCORE_SIZE_ERROR ((size_t) -1)
+
+
+// Exported from a library built with -fvisibility=hidden
+#define KCORE_API __attribute__((visibility("default")))
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+// Network with thresholds and random number generator state, opaque
+typedef struct kcore_network kcore_network;
+
+
+// Version of the library, compare with KCORE_API_VERSION
+KCORE_API int kcore_api_version(void);
+
+
+/*-------------------------------------------------------------------------------
+ * Building, seed holds the 4 integers of a seed.dat file
+ * Thresholds are 0 until set, NULL is returned for invalid input or no memory,
+ * a network has at least one node
+-------------------------------------------------------------------------------*/
+
+
+// Network with poissonian degree distribution, same links as lt_ER_algo in net_algo.hpp
+KCORE_API kcore_network * kcore_build_er(int num_nodes, double avg_degree, const int seed[4]);
+
+
+// Network from a list of links, link_ends holds the 2 end nodes of every link
+KCORE_API kcore_network * kcore_build_links(int num_nodes, size_t num_links, const int *link_ends,
+					    const int seed[4]);
+
+
+// Configuration model network with the given degree of every node, see net_config_model.hpp
+KCORE_API kcore_network * kcore_build_config(int num_nodes, const int *degree, const int seed[4],
+					     int num_threads);
+
+
+// Frees the network, NULL is ignored
+KCORE_API void kcore_free(kcore_network *net);
+
+
+/*-------------------------------------------------------------------------------
+ * Network properties and thresholds
+-------------------------------------------------------------------------------*/
+
+
+KCORE_API int kcore_num_nodes(const kcore_network *net);
+KCORE_API size_t kcore_num_links(const kcore_network *net);
+
+
+// Seeds for the next network, the numbers a driver writes back to seed.dat
+KCORE_API void kcore_get_seed(const kcore_network *net, int seed[4]);
+
+
+// Local kcore threshold of every node from an array of num_nodes values, returns KCORE_OK or an error
+KCORE_API int kcore_set_thresholds(kcore_network *net, const int *threshold);
+
+
+// Random thresholds as set_init_threshold_frac in net_algo.hpp, returns KCORE_OK or an error
+KCORE_API int kcore_set_thresholds_frac(kcore_network *net, int threshold1, double prob_thresh1, int threshold2);
+
+
+/*-------------------------------------------------------------------------------
+ * Runs on a live degree array of num_nodes entries owned by the caller
+ * A negative result is an error code, the live degree array is then not usable
+-------------------------------------------------------------------------------*/
+
+
+// All links present
+KCORE_API void kcore_reset(kcore_network *net, int *live_degree);
+
+
+// Removes a fraction 1-p of randomly chosen nodes, returns KCORE_OK or an error
+KCORE_API int kcore_attack(kcore_network *net, double p, int *live_degree);
+
+
+// Removes nodes with degree below the local threshold, returns the number of prune scans
+KCORE_API int kcore_prune(kcore_network *net, int *live_degree);
+
+
+// Attack and prune, returns the number of prune scans
+KCORE_API int kcore_attack_and_prune(kcore_network *net, double p, int *live_degree);
+
+
+// Size of the biggest cluster, its nodes are written to cluster (num_nodes entries) unless NULL,
+// KCORE_SIZE_ERROR on an error
+KCORE_API size_t kcore_biggest_cluster(kcore_network *net, const int *live_degree, int *cluster);
+
+
+/*-------------------------------------------------------------------------------
+ * Sweep: for every percolation probability resets, attacks, prunes and writes the
+ * fraction of nodes in the biggest cluster to gc and the prune scans to scans (unless NULL)
+ * live_degree is the work array, it holds the state of the last probability at the end
+ * Returns KCORE_OK or an error
+-------------------------------------------------------------------------------*/
+
+
+KCORE_API int kcore_sweep(kcore_network *net, const double *probs, int num_probs, int *live_degree,
+			   double *gc, int *scans);
+
+
+#ifdef __cplusplus
+}
+
+
+/*-------------------------------------------------------------------------------
+ * C++ interface: owns a network and frees it, live degree arrays in vectors
+-------------------------------------------------------------------------------*/
+
+
+#include <vector>
+
+#include <new>
+
+#include <stdexcept>
+
+
+class Kcore_network {
+
+protected:
+
+  kcore_network *net;
+
+  // Error codes of the library as exceptions
+  static int check(int result) {
+    if (result == KCORE_ERROR_NO_MEMORY) throw std::bad_alloc();
+    if (result < 0) throw std::runtime_error("kcore library error");
+    return result; }
+
+  Kcore_network(const Kcore_network &);
+  Kcore_network & operator=(const Kcore_network &);
+
+public:
+
+  static Kcore_network er(int num_nodes, double avg_degree, const int seed[4]) {
+    return Kcore_network(kcore_build_er(num_nodes, avg_degree, seed)); }
+
+  static Kcore_network links(int num_nodes, const std::vector<int> &link_ends, const int seed[4]) {
+    return Kcore_network(kcore_build_links(num_nodes, link_ends.size() / 2, link_ends.data(), seed)); }
+
+  static Kcore_network config(const std::vector<int> &degree, const int seed[4], int num_threads = 0) {
+    return Kcore_network(kcore_build_config(int(degree.size()), degree.data(), seed, num_threads)); }
+
+  int num_nodes() const { return kcore_num_nodes(net); }
+  size_t num_links() const { return kcore_num_links(net); }
+
+  void set_thresholds(const std::vector<int> &threshold) { check(kcore_set_thresholds(net, threshold.data())); }
+  void set_thresholds_frac(int threshold1, double prob_thresh1, int threshold2) {
+    check(kcore_set_thresholds_frac(net, threshold1, prob_thresh1, threshold2)); }
+
+  void reset(std::vector<int> &live_degree) {
+    live_degree.resize(num_nodes());
+    kcore_reset(net, live_degree.data()); }
+
+  int attack_and_prune(double p, std::vector<int> &live_degree) {
+    return check(kcore_attack_and_prune(net, p, live_degree.data())); }
+
+  size_t biggest_cluster(const std::vector<int> &live_degree, std::vector<int> &cluster) {
+    cluster.resize(num_nodes());
+    size_t size = kcore_biggest_cluster(net, live_degree.data(), cluster.data());
+    if (size == KCORE_SIZE_ERROR) throw std::bad_alloc();
+    cluster.resize(size);
+    return size; }
+
+  void sweep(const std::vector<double> &probs, std::vector<int> &live_degree, std::vector<double> &gc,
+	     std::vector<int> &scans) {
+    live_degree.resize(num_nodes());
+    gc.resize(probs.size());
+    scans.resize(probs.size());
+    check(kcore_sweep(net, probs.data(), int(probs.size()), live_degree.data(), gc.data(), scans.data())); }
+
+  kcore_network * get() { return net; }
+
+  explicit Kcore_network(kcore_network *net_inp) : net(net_inp) {
+    if (!net) throw std::runtime_error("kcore network could not be built"); }
+
+  Kcore_network(Kcore_network &&other) : net(other.net) { other.net = 0; }
+
+  ~Kcore_network() { kcore_free(net); }
+};
+
+#endif
+
+
+#endif
@@ -16,7 +16,8 @@
 -------------------------------------------------------------------------------*/
 
 
-inline void lt_ER_algo(Graph & network, float avg_degree)
+template <class Alloc>
+inline void lt_ER_algo(Graph_t<Alloc> & network, float avg_degree)
 {
 
   
@@ -47,7 +48,8 @@ inline void lt_ER_algo(Graph & network, float avg_degree)
 -------------------------------------------------------------------------------*/
 
 
-void build_complete_dependence(Graph &network1, Graph &network2)
+template <class Alloc>
+void build_complete_dependence(Graph_t<Alloc> &network1, Graph_t<Alloc> &network2)
 {
 
   int num_nodes = network1.size();
@@ -67,7 +69,8 @@ void build_complete_dependence(Graph &network1, Graph &network2)
 -------------------------------------------------------------------------------*/
 
 
-void build_partial_dependence(Graph &network1, Graph &network2, double coupling){
+template <class Alloc>
+void build_partial_dependence(Graph_t<Alloc> &network1, Graph_t<Alloc> &network2, double coupling){
 
   int num_dep_nodes;
   int num_nodes = network1.size();
@@ -129,7 +132,8 @@ void build_partial_dependence(Graph &network1, Graph &network2, double coupling)
 -------------------------------------------------------------------------------*/
 
 
-void set_init_threshold_frac(Graph &net, int threshold1, double prob_thresh1, int threshold2 , double prob_thresh2){
+template <class Alloc>
+void set_init_threshold_frac(Graph_t<Alloc> &net, int threshold1, double prob_thresh1, int threshold2 , double prob_thresh2){
 
    int num_nodes = net.get_num_vertices(); 
    int node_idx;
@@ -0,0 +1,214 @@
+/*-------------------------------------------------------------------------------
+ * Arena allocator for the neighbor lists of Node and Graph
+ * 1. Arena hands out memory from large blocks, one bump of a pointer per list element
+ * 2. Arena_allocator is the allocator for Node_t and Graph_t that uses one arena
+ * Elements are never freed one by one, all memory of an arena is released at once,
+ * so every graph should own its arena
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+
+#ifndef NET_ARENA_HPP
+#define NET_ARENA_HPP
+
+
+/*-----------------------------------------------------------------------------*/
+
+#include <stdlib.h>
+
+#include <stddef.h>
+
+#include <new>
+
+#include <type_traits>
+
+#include <vector>
+
+/*-----------------------------------------------------------------------------*/
+
+
+class Arena {
+
+protected:
+
+  // Blocks of memory, blocks after block_in_use are kept for reuse
+  vector<char *> blocks;
+  vector<size_t> block_sizes;
+
+
+  // Block being filled and position in it
+  size_t block_in_use;
+  size_t used;
+
+
+  // Size of the next new block
+  size_t block_size;
+
+
+public:
+
+  void * allocate(size_t bytes, size_t align = alignof(max_align_t));
+  void reset();
+  void release();
+  size_t get_capacity();
+
+
+  // Constructor
+  Arena(size_t first_block_size = size_t(1) << 20) {
+    block_size = first_block_size;
+    block_in_use = 0;
+    used = 0;
+  }
+
+  ~Arena() { release(); }
+
+  // An arena owns its blocks, it is neither copied nor assigned
+  Arena(const Arena &) = delete;
+  Arena & operator=(const Arena &) = delete;
+};
+
+//------------------------------Member function definitions----------------------
+/*-------------------------------------------------------------------------------
+ * @param number of bytes
+ * @param alignment, a power of two up to that of any type
+ * @Returns aligned memory taken from the block in use
+ * Moves to the next block (kept or new) when the block in use is full
+-------------------------------------------------------------------------------*/
+
+
+inline void * Arena::allocate(size_t bytes, size_t align)
+{
+  used = (used + align - 1) & ~(align - 1);
+
+  while (block_in_use < blocks.size() && used + bytes > block_sizes[block_in_use]) {
+    ++block_in_use;
+    used = 0;
+  }
+
+  if (block_in_use == blocks.size()) {
+
+    // Blocks grow so the number of blocks stays small for large graphs
+    size_t new_size = block_size > bytes ? block_size : bytes;
+    char *block = (char *) malloc(new_size);
+    if (!block) throw bad_alloc();
+
+    blocks.push_back(block);
+    block_sizes.push_back(new_size);
+    block_size *= 2;
+    used = 0;
+  }
+
+  void *ptr = blocks[block_in_use] + used;
+  used += bytes;
+  return ptr;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * Marks all memory as free, blocks are kept and filled again from the first
+-------------------------------------------------------------------------------*/
+
+
+inline void Arena::reset()
+{
+  block_in_use = 0;
+  used = 0;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * Returns all blocks to the system
+-------------------------------------------------------------------------------*/
+
+
+inline void Arena::release()
+{
+  for (size_t b = 0; b < blocks.size(); ++b) free(blocks[b]);
+  blocks.clear();
+  block_sizes.clear();
+  block_in_use = 0;
+  used = 0;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @Returns number of bytes held by the arena
+-------------------------------------------------------------------------------*/
+
+
+inline size_t Arena::get_capacity()
+{
+  size_t capacity = 0;
+  for (size_t b = 0; b < block_sizes.size(); ++b) capacity += block_sizes[b];
+  return capacity;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * Allocator using an arena, deallocate does nothing
+ * Containers keep their own arena when assigned or swapped, an arena must be given
+-------------------------------------------------------------------------------*/
+
+
+template <class T>
+class Arena_allocator {
+
+public:
+
+  typedef T value_type;
+
+  typedef false_type propagate_on_container_copy_assignment;
+  typedef false_type propagate_on_container_move_assignment;
+  typedef false_type propagate_on_container_swap;
+
+  Arena *arena;
+
+  T * allocate(size_t n) { return (T *) arena->allocate(n * sizeof(T), alignof(T)); }
+  void deallocate(T *, size_t) {}
+
+  // Constructors, there is no allocator without an arena
+  Arena_allocator(Arena *arena_inp) : arena(arena_inp) {}
+
+  template <class U>
+  Arena_allocator(const Arena_allocator<U> &other) : arena(other.arena) {}
+};
+
+
+template <class T, class U>
+inline bool operator==(const Arena_allocator<T> &a, const Arena_allocator<U> &b) { return a.arena == b.arena; }
+
+template <class T, class U>
+inline bool operator!=(const Arena_allocator<T> &a, const Arena_allocator<U> &b) { return a.arena != b.arena; }
+
+
+/*-------------------------------------------------------------------------------
+ * Called by Graph_t::copy_from when all lists of the graph are destroyed
+ * The whole arena is marked free at once, unless the graph to be copied uses it too
+-------------------------------------------------------------------------------*/
+
+
+template <class T, class Other_alloc>
+inline void release_list_storage(Arena_allocator<T> &alloc, const Other_alloc &)
+{
+  alloc.arena->reset();
+}
+
+
+template <class T, class U>
+inline void release_list_storage(Arena_allocator<T> &alloc, const Arena_allocator<U> &other_alloc)
+{
+  if (alloc.arena != other_alloc.arena) alloc.arena->reset();
+}
+
+
+/*-------------------------------------------------------------------------------
+ * Lists of an arena are not reused by assignment, Graph_t::operator= copies instead,
+ * and a graph of an arena has no copy constructor
+-------------------------------------------------------------------------------*/
+
+
+template <class T>
+inline false_type reuses_freed_lists(const Arena_allocator<T> &) { return false_type(); }
+
+
+#endif
@@ -0,0 +1,147 @@
+/*-------------------------------------------------------------------------------
+ * Avalanches caused by removing a single node from a pruned network
+ * 1. Undo_log keeps the old live degree of every change, so a probe is undone in
+ *    time proportional to the avalanche
+ * 2. Avalanche_prober removes one node, prunes the cascade one generation at a time,
+ *    records the size and the depth of the avalanche and undoes it
+ * Probes start from a network that satisfies the kcore condition, every probe sees
+ * the same network
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+
+#ifndef NET_AVALANCHE_HPP
+#define NET_AVALANCHE_HPP
+
+
+/*-----------------------------------------------------------------------------*/
+
+#include <vector>
+
+#include "flat_graph.hpp"
+
+#include "net_ops_flat.hpp"
+
+/*-----------------------------------------------------------------------------*/
+
+
+/*-------------------------------------------------------------------------------
+ * Live degree changes of a probe, undone in reverse order
+-------------------------------------------------------------------------------*/
+
+
+class Undo_log {
+
+protected:
+
+  // Node and its live degree before every change
+  vector<int> nodes;
+  vector<int> old_degrees;
+
+public:
+
+  void set(vector<int> &degree, int node_idx, int new_degree) {
+    nodes.push_back(node_idx);
+    old_degrees.push_back(degree[node_idx]);
+    degree[node_idx] = new_degree;
+  }
+
+  void rollback(vector<int> &degree) {
+    for (size_t c = nodes.size(); c-- > 0;) degree[nodes[c]] = old_degrees[c];
+    nodes.clear();
+    old_degrees.clear();
+  }
+
+  size_t size() { return nodes.size(); }
+};
+
+
+/*-------------------------------------------------------------------------------
+ * Removes single nodes from a pruned network and measures the avalanches
+ * Keeps the frontiers and the undo log between probes, so probes do not allocate
+-------------------------------------------------------------------------------*/
+
+
+class Avalanche_prober {
+
+protected:
+
+  Undo_log undo;
+  vector<int> frontier, next;
+
+public:
+
+  // Removes a node, prunes and undoes, returns the size of the avalanche
+  template <class Threshold>
+  long probe(Flat_graph &net, vector<int> &degree, const Threshold &threshold, int node_idx, int &depth);
+};
+
+//------------------------------Member function definitions----------------------
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param live degree of every node, pruned, the same after the call
+ * @param threshold access, called with the node index
+ * @param integer index of the node to be removed
+ * @param integer to store the depth, the last generation that removed a node
+ * The probed node is generation 0, every later generation removes the nodes brought
+ * below their threshold by the one before, as prune_generations in net_parallel.hpp
+ * Nodes whose last live neighbor is removed count as removed too
+ * @return size of the avalanche, the number of nodes removed including the probed node,
+ * 0 if the node was already removed
+-------------------------------------------------------------------------------*/
+
+
+template <class Threshold>
+inline long Avalanche_prober::probe(Flat_graph &net, vector<int> &degree, const Threshold &threshold,
+				    int node_idx, int &depth)
+{
+  depth = 0;
+  if (degree[node_idx] == 0) return 0;
+
+  long size = 0;
+  int generation = 0;
+
+  frontier.clear();
+  frontier.push_back(node_idx);
+
+  Flat_graph::node_neighbor_iterator it;
+
+  while (true) {
+
+    // Nodes of the frontier that still have live links
+    size_t num_kept = 0;
+    for (size_t f = 0; f < frontier.size(); ++f)
+      if (degree[frontier[f]] > 0) {
+	undo.set(degree, frontier[f], 0);
+	frontier[num_kept++] = frontier[f];
+      }
+    frontier.resize(num_kept);
+
+    if (frontier.empty()) break;
+
+    depth = generation++;
+    size += frontier.size();
+
+    next.clear();
+    for (size_t f = 0; f < frontier.size(); ++f)
+      for (it = net.vertex_neighbor_begin(frontier[f]); it != net.vertex_neighbor_end(frontier[f]); ++it) {
+	int nb = *it;
+	if (degree[nb] == 0) continue;
+
+	int old_degree = degree[nb];
+	undo.set(degree, nb, old_degree - 1);
+
+	if (old_degree == 1) ++size;
+	else if (old_degree == threshold(nb)) next.push_back(nb);
+      }
+
+    frontier.swap(next);
+  }
+
+  undo.rollback(degree);
+
+  return size;
+}
+
+
+#endif
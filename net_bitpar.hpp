@@ -0,0 +1,345 @@
+/*-------------------------------------------------------------------------------
+ * Bit parallel percolation process on a Flat_graph snapshot
+ * Every node carries a 64 bit alive mask, bit l is the state of the node in realization l
+ * 64 independent attacks (with the same or with different percolation probabilities)
+ * are pruned and searched for their biggest cluster together with word wide operations
+ * 1. Function to remove randomly chosen nodes in every realization
+ * 2. Prune all realizations to satisfy kcore condition
+ * 3. Function to find the biggest cluster size in every realization, and optionally the
+ *    nodes of the biggest cluster as one mask per node
+ * A node that is not alive in a realization has no links there, a cluster of its own
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+
+#ifndef NET_BITPAR_HPP
+#define NET_BITPAR_HPP
+
+
+/*-----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "flat_graph.hpp"
+
+/*-----------------------------------------------------------------------------*/
+
+
+// Number of realizations simulated together
+const int num_bitpar_lanes = 64;
+
+
+/*-------------------------------------------------------------------------------
+ * Counts 64 realizations at once: plane j holds bit j of the count of every realization
+ * Adding a mask increments the count of the realizations whose bit is set
+-------------------------------------------------------------------------------*/
+
+
+class Bitsliced_counter {
+
+protected:
+
+  vector<uint64_t> planes;
+
+public:
+
+  void clear() { planes.clear(); }
+
+
+  // Ripple carry add of one to every realization in the mask
+  void add(uint64_t mask) {
+    for (size_t j = 0; mask; ++j) {
+      if (j == planes.size()) planes.push_back(0);
+      uint64_t carry = planes[j] & mask;
+      planes[j] ^= mask;
+      mask = carry;
+    }
+  }
+
+
+  // Returns the count of realization lane
+  long get_count(int lane) {
+    long count = 0;
+    for (size_t j = 0; j < planes.size(); ++j)
+      count |= long((planes[j] >> lane) & 1) << j;
+    return count;
+  }
+};
+
+
+/*-------------------------------------------------------------------------------
+ * @param vector with one percolation probability per realization, at most 64
+ * @param graph snapshot
+ * @param vector to store the alive mask of every node
+ * Realization l draws random numbers exactly as the l-th of consecutive calls of
+ * initial_random_attack would, so every realization equals a sequential run
+ * Random choices are made in the index of the built network, as in initial_random_attack
+ * Bits of unused realizations are left 0
+-------------------------------------------------------------------------------*/
+
+
+inline void bitpar_random_attack(const vector<double> &p, Flat_graph &net, vector<uint64_t> &alive)
+{
+  int num_nodes = net.get_num_vertices();
+  int num_lanes = p.size();
+
+  uint64_t all_lanes = num_lanes >= 64 ? ~uint64_t(0) : (uint64_t(1) << num_lanes) - 1;
+  alive.assign(num_nodes, all_lanes);
+
+  for (int lane = 0; lane < num_lanes; ++lane) {
+
+    uint64_t bit = uint64_t(1) << lane;
+    int num_removed = 0;
+    int num_init_attack = int((1. - p[lane]) * num_nodes);
+
+    // A node is counted once even if it is chosen again
+    while (num_removed < num_init_attack) {
+      int node_idx = net.get_label(int(srand() * num_nodes));
+      if (alive[node_idx] & bit) {
+	alive[node_idx] &= ~bit;
+	++num_removed;
+      }
+    }
+  }
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param alive mask of every node
+ * @param integer index of the node
+ * @param scratch vector with at least threshold+1 words
+ * @Returns mask of realizations in which the node has at least threshold alive neighbors
+ * count_at_least[c] collects realizations with at least c alive neighbors seen so far
+-------------------------------------------------------------------------------*/
+
+
+inline uint64_t bitpar_enough_neighbors(Flat_graph &net, vector<uint64_t> &alive, int node_idx,
+					vector<uint64_t> &count_at_least)
+{
+  int threshold = net.get_threshold(node_idx);
+  if (threshold <= 0) return ~uint64_t(0);
+
+  count_at_least[0] = ~uint64_t(0);
+  for (int c = 1; c <= threshold; ++c) count_at_least[c] = 0;
+
+  Flat_graph::node_neighbor_iterator it;
+  for (it = net.vertex_neighbor_begin(node_idx); it != net.vertex_neighbor_end(node_idx); ++it) {
+    uint64_t nb_alive = alive[*it];
+    for (int c = threshold; c >= 1; --c)
+      count_at_least[c] |= count_at_least[c-1] & nb_alive;
+
+    // Stop when every realization of the node already has enough neighbors
+    if ((count_at_least[threshold] & alive[node_idx]) == alive[node_idx]) break;
+  }
+
+  return count_at_least[threshold];
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param alive mask of every node
+ * Removes a node in every realization in which it has less alive neighbors than its threshold
+ * Only nodes whose neighbors changed are visited again, in scans of increasing node index
+ * @return count of the number of prune scans
+-------------------------------------------------------------------------------*/
+
+
+inline int bitpar_network_prune(Flat_graph &net, vector<uint64_t> &alive)
+{
+  int num_nodes = net.get_num_vertices();
+  int num_words = (num_nodes + 63) / 64;
+
+  int max_threshold = 0;
+  for (int i = 0; i < num_nodes; ++i)
+    if (net.get_threshold(i) > max_threshold) max_threshold = net.get_threshold(i);
+  vector<uint64_t> count_at_least(max_threshold + 1);
+
+  // Nodes to be visited in the present and in the next scan, all nodes at the start
+  vector<uint64_t> current(num_words, ~uint64_t(0)), next(num_words, 0);
+  if (num_nodes % 64) current[num_words-1] = (uint64_t(1) << (num_nodes % 64)) - 1;
+
+  int num_prune_iterations = 0;
+  bool removed_any;
+
+  Flat_graph::node_neighbor_iterator it;
+
+  do {
+
+    ++num_prune_iterations;
+    removed_any = false;
+
+    for (int w = 0; w < num_words; ++w) {
+      while (current[w]) {
+
+	int node_idx = w * 64 + __builtin_ctzll(current[w]);
+	current[w] &= current[w] - 1;
+
+	if (!alive[node_idx]) continue;
+
+	uint64_t kill = alive[node_idx] & ~bitpar_enough_neighbors(net, alive, node_idx, count_at_least);
+	if (!kill) continue;
+
+	alive[node_idx] &= ~kill;
+	removed_any = true;
+
+	// Neighbors alive in the affected realizations need to be checked again
+	for (it = net.vertex_neighbor_begin(node_idx); it != net.vertex_neighbor_end(node_idx); ++it)
+	  if (alive[*it] & kill) {
+	    if (*it > node_idx) current[*it / 64] |= uint64_t(1) << (*it % 64);
+	    else next[*it / 64] |= uint64_t(1) << (*it % 64);
+	  }
+      }
+    }
+
+    current.swap(next);
+
+  } while (removed_any);
+
+  return num_prune_iterations;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param alive mask of every node
+ * @param vector to store the biggest cluster size of every realization (64 entries)
+ * Clusters are grown for all realizations together: in every round each unfinished
+ * realization starts from its first unvisited alive node, taken in order of decreasing degree,
+ * and one breadth first search with masks visits the cluster of every realization at once
+ * Breadth first order keeps the realizations in step, a node waiting in the queue collects
+ * the bits of all the realizations that reach it before it is visited
+ * A realization is finished when its biggest cluster is larger than its unvisited alive nodes
+ * @param optional vector to store the biggest cluster mask of every node, bit l set if the
+ * node is in the biggest cluster of realization l, found by one more search from the start
+ * nodes of the biggest clusters, a realization without a cluster of 2 or more nodes has none
+-------------------------------------------------------------------------------*/
+
+
+inline void bitpar_find_biggest_clusters(Flat_graph &net, vector<uint64_t> &alive, vector<long> &biggest_size,
+					 vector<uint64_t> *in_biggest = 0)
+{
+  int num_nodes = net.get_num_vertices();
+  biggest_size.assign(num_bitpar_lanes, num_nodes > 0 ? 1 : 0);
+  if (num_nodes == 0) return;
+
+  // Order of start nodes: decreasing degree, so the first round usually starts in the giant cluster
+  int max_degree = 0;
+  for (int i = 0; i < num_nodes; ++i)
+    if (net.get_deg_vertex(i) > max_degree) max_degree = net.get_deg_vertex(i);
+  vector<int> first_of_degree(max_degree + 2, 0);
+  for (int i = 0; i < num_nodes; ++i) ++first_of_degree[max_degree - net.get_deg_vertex(i) + 1];
+  for (int d = 1; d <= max_degree + 1; ++d) first_of_degree[d] += first_of_degree[d-1];
+  vector<int> start_order(num_nodes);
+  for (int i = 0; i < num_nodes; ++i) start_order[first_of_degree[max_degree - net.get_deg_vertex(i)]++] = i;
+
+
+  // Number of alive nodes not yet visited in every realization
+  Bitsliced_counter counter;
+  for (int i = 0; i < num_nodes; ++i) counter.add(alive[i]);
+  vector<long> num_unvisited(num_bitpar_lanes);
+  for (int lane = 0; lane < num_bitpar_lanes; ++lane) num_unvisited[lane] = counter.get_count(lane);
+
+  vector<uint64_t> visited(num_nodes, 0);
+  vector<uint64_t> pending(num_nodes, 0);
+  vector<int> search_queue;
+  vector<int> next_start(num_bitpar_lanes, 0);
+
+  // Start node of the biggest cluster of every realization, -1 while it is a single node
+  vector<int> biggest_start(num_bitpar_lanes, -1);
+
+  Flat_graph::node_neighbor_iterator it;
+
+  while (true) {
+
+    // Choose the start node of every unfinished realization
+    uint64_t round_lanes = 0;
+    counter.clear();
+
+    for (int lane = 0; lane < num_bitpar_lanes; ++lane) {
+
+      if (num_unvisited[lane] <= biggest_size[lane]) continue;
+
+      uint64_t bit = uint64_t(1) << lane;
+      int &pos = next_start[lane];
+      while (pos < num_nodes && !(alive[start_order[pos]] & ~visited[start_order[pos]] & bit)) ++pos;
+      if (pos == num_nodes) continue;
+
+      int start = start_order[pos];
+      round_lanes |= bit;
+      visited[start] |= bit;
+      if (!pending[start]) search_queue.push_back(start);
+      pending[start] |= bit;
+      counter.add(bit);
+    }
+
+    if (!round_lanes) break;
+
+    // Grow the clusters of all the realizations of this round together
+    for (size_t head = 0; head < search_queue.size(); ++head) {
+
+      int idx_search = search_queue[head];
+
+      uint64_t bits = pending[idx_search];
+      pending[idx_search] = 0;
+
+      for (it = net.vertex_neighbor_begin(idx_search); it != net.vertex_neighbor_end(idx_search); ++it) {
+	uint64_t new_bits = bits & alive[*it] & ~visited[*it];
+	if (new_bits) {
+	  visited[*it] |= new_bits;
+	  if (!pending[*it]) search_queue.push_back(*it);
+	  pending[*it] |= new_bits;
+	  counter.add(new_bits);
+	}
+      }
+    }
+    search_queue.clear();
+
+    for (int lane = 0; lane < num_bitpar_lanes; ++lane)
+      if (round_lanes & (uint64_t(1) << lane)) {
+	long cluster_size = counter.get_count(lane);
+	num_unvisited[lane] -= cluster_size;
+	if (cluster_size > biggest_size[lane]) {
+	  biggest_size[lane] = cluster_size;
+	  biggest_start[lane] = start_order[next_start[lane]];
+	}
+      }
+  }
+
+  if (!in_biggest) return;
+
+  // Search again from the start of every biggest cluster, all realizations together
+  vector<uint64_t> &member = *in_biggest;
+  member.assign(num_nodes, 0);
+
+  for (int lane = 0; lane < num_bitpar_lanes; ++lane) {
+    int start = biggest_start[lane];
+    if (start < 0) continue;
+    if (!pending[start]) search_queue.push_back(start);
+    member[start] |= uint64_t(1) << lane;
+    pending[start] |= uint64_t(1) << lane;
+  }
+
+  for (size_t head = 0; head < search_queue.size(); ++head) {
+
+    int idx_search = search_queue[head];
+
+    uint64_t bits = pending[idx_search];
+    pending[idx_search] = 0;
+
+    for (it = net.vertex_neighbor_begin(idx_search); it != net.vertex_neighbor_end(idx_search); ++it) {
+      uint64_t new_bits = bits & alive[*it] & ~member[*it];
+      if (new_bits) {
+	member[*it] |= new_bits;
+	if (!pending[*it]) search_queue.push_back(*it);
+	pending[*it] |= new_bits;
+      }
+    }
+  }
+}
+
+
+#endif
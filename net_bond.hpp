@@ -0,0 +1,349 @@
+/*-------------------------------------------------------------------------------
+ * Bond percolation on a Flat_graph snapshot: links fail instead of nodes
+ * Every link gets an id in a flat link array with the slots of its two ends in the
+ * neighbor blocks, a failed link is cleared in both slots, so failing a link costs
+ * O(1) and the network is never copied
+ * Links fail in one random order, the network at percolation probability p has the
+ * first int((1-p)M) links of the order failed, so a sweep from p = 1 downwards only
+ * fails the links of every step and prunes from the state of the step before
+ * A kcore of a network with fewer links is inside the kcore of the network with more,
+ * so the pruned state of every step is the state a fresh run would reach
+ * 1. Flat link array, failure order and link state
+ * 2. Prune network with failed links to satisfy kcore condition
+ * 3. Function to find the biggest cluster using present links only
+ * The state of a run is the live degree of every node as in net_ops_flat.hpp, a node
+ * whose links all failed has degree 0 and is removed
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+
+#ifndef NET_BOND_HPP
+#define NET_BOND_HPP
+
+
+/*-----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <stack>
+
+#include <algorithm>
+
+#include "flat_graph.hpp"
+
+#include "net_ops_flat.hpp"
+
+/*-----------------------------------------------------------------------------*/
+
+
+template <class Vertex = int, class Offset = long>
+class Bond_links {
+
+protected:
+
+  // Link e joins nodes link_end[2e] and link_end[2e+1]
+  vector<Vertex> link_end;
+
+
+  // Slots of the two ends of link e in the neighbor blocks
+  vector<Offset> link_slot;
+
+
+  // 1 while the link of a slot is present
+  vector<char> slot_present;
+
+
+  // Link ids in the order they fail, and number of failed links
+  vector<Offset> order;
+  Offset num_failed;
+
+public:
+
+  Bond_links(Flat_graph_t<Vertex, Offset> &net);
+
+
+  Offset get_num_links() { return order.size(); }
+  Offset get_num_failed() { return num_failed; }
+  bool is_present(Offset slot) { return slot_present[slot]; }
+
+
+  // New random failure order, from srand()
+  void random_order();
+
+
+  // All links present, live degree reset to the snapshot
+  template <class Degrees>
+  void reset(Flat_graph_t<Vertex, Offset> &net, Degrees &degree);
+
+
+  // Fails links of the order until num_total have failed
+  template <class Degrees>
+  void fail_links(Offset num_total, Flat_graph_t<Vertex, Offset> &net, Degrees &degree,
+		  vector<uint64_t> &candidates);
+};
+
+
+/*-------------------------------------------------------------------------------
+ * @param percolation probability, the fraction of links that do not fail
+ * @param number of links
+ * @Returns number of failed links, as initial_random_attack counts removed nodes
+-------------------------------------------------------------------------------*/
+
+
+template <class Offset>
+inline Offset num_failed_links(double p, Offset num_links)
+{
+  return Offset((1. - p) * num_links);
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param present links
+ * @param live degree of every node
+ * @param bitmask of nodes to be visited in the first scan, used up
+ * Pruning = Remove links from all nodes whose degree is less than its local kcore threshold
+ * Scans in increasing node index as prune_scans, a removed node only lowers the degree
+ * of neighbors through links that are present
+ * @return count of the number of prune scans
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset, class Degrees>
+inline int bond_network_prune(Flat_graph_t<Vertex, Offset> &net, Bond_links<Vertex, Offset> &links,
+			      Degrees &degree, vector<uint64_t> &current)
+{
+  const int *threshold = net.threshold_data();
+  const Vertex *first = net.vertex_neighbor_begin(0);
+
+  vector<uint64_t> next(current.size(), 0);
+
+  int num_prune_iterations = 0;
+  bool removed_any;
+
+  do {
+
+    ++num_prune_iterations;
+    removed_any = false;
+
+    for (size_t w = 0; w < current.size(); ++w) {
+      while (current[w]) {
+
+	Vertex node_idx = Vertex(w * 64 + __builtin_ctzll(current[w]));
+	current[w] &= current[w] - 1;
+
+	if (!(degree[node_idx] > 0 && degree[node_idx] < threshold[node_idx]))
+	  continue;
+
+	Offset slot_end = net.vertex_neighbor_end(node_idx) - first;
+	for (Offset s = net.vertex_neighbor_begin(node_idx) - first; s < slot_end; ++s) {
+	  Vertex nb = first[s];
+	  if (!links.is_present(s) || degree[nb] <= 0) continue;
+
+	  --degree[nb];
+	  if (degree[nb] > 0 && degree[nb] < threshold[nb]) {
+	    if (nb > node_idx) current[nb / 64] |= uint64_t(1) << (nb % 64);
+	    else next[nb / 64] |= uint64_t(1) << (nb % 64);
+	  }
+	}
+
+	degree[node_idx] = 0;
+	removed_any = true;
+      }
+    }
+
+    current.swap(next);
+
+  } while (removed_any);
+
+  return num_prune_iterations;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param present links
+ * @param live degree of every node
+ * @param input vector to store indices of nodes in biggest connected cluster
+ * Finds the biggest connected cluster using present links between live nodes
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset, class Degrees>
+inline void bond_find_biggest_cluster(Flat_graph_t<Vertex, Offset> &net, Bond_links<Vertex, Offset> &links,
+				      Degrees &degree, vector<Vertex> &biggest_cluster)
+{
+  biggest_cluster.clear();
+  Vertex num_nodes = net.get_num_vertices();
+  const Vertex *first = net.vertex_neighbor_begin(0);
+
+  vector<char> marked(num_nodes, 0);
+  stack<Vertex> search_stack;
+  vector<Vertex> temp_cluster;
+
+  for (Vertex idx_node = 0; idx_node < num_nodes; ++idx_node) {
+
+    if (marked[idx_node]) continue;
+
+    temp_cluster.clear();
+    temp_cluster.push_back(idx_node);
+    marked[idx_node] = 1;
+
+    if (degree[idx_node] > 0)
+      search_stack.push(idx_node);
+
+    while (!search_stack.empty()) {
+
+      Vertex idx_search = search_stack.top();
+      search_stack.pop();
+
+      Offset slot_end = net.vertex_neighbor_end(idx_search) - first;
+      for (Offset s = net.vertex_neighbor_begin(idx_search) - first; s < slot_end; ++s) {
+	Vertex nb = first[s];
+	if (links.is_present(s) && degree[nb] > 0 && !marked[nb]) {
+	  search_stack.push(nb);
+	  temp_cluster.push_back(nb);
+	  marked[nb] = 1;
+	}
+      }
+    }
+
+    if (temp_cluster.size() > biggest_cluster.size())
+      biggest_cluster = temp_cluster;
+  }
+}
+
+
+//------------------------------Member function definitions----------------------
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * Numbers the links in the order of their smaller end node and pairs the two slots of
+ * every link: the links of node u to smaller nodes v are made while v is visited, in
+ * increasing v, and are matched with the slots of u sorted by neighbor
+ * Links are present and fail in the order of their ids until random_order is called
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+inline Bond_links<Vertex, Offset>::Bond_links(Flat_graph_t<Vertex, Offset> &net) : num_failed(0)
+{
+  Vertex num_nodes = net.get_num_vertices();
+  const Vertex *first = net.vertex_neighbor_begin(0);
+
+  Offset num_slots = net.vertex_neighbor_end(num_nodes - 1) - first;
+  Offset num_links = num_slots / 2;
+
+  link_end.resize(2 * num_links);
+  link_slot.resize(2 * num_links);
+  slot_present.assign(num_slots, 1);
+
+  // Links to smaller nodes of every node, in the order they are made
+  vector<Offset> smaller_start(num_nodes + 1, 0);
+  for (Vertex u = 0; u < num_nodes; ++u) {
+    Offset count = 0;
+    for (const Vertex *it = net.vertex_neighbor_begin(u); it != net.vertex_neighbor_end(u); ++it)
+      if (*it < u) ++count;
+    smaller_start[u+1] = smaller_start[u] + count;
+  }
+
+  vector<Offset> smaller_link(smaller_start[num_nodes]);
+  vector<Offset> fill(smaller_start.begin(), smaller_start.end() - 1);
+  vector<pair<Vertex, Offset> > smaller_slots;
+
+  Offset e = 0;
+  for (Vertex u = 0; u < num_nodes; ++u) {
+
+    smaller_slots.clear();
+
+    for (const Vertex *it = net.vertex_neighbor_begin(u); it != net.vertex_neighbor_end(u); ++it) {
+      Offset s = it - first;
+      if (*it > u) {
+	link_end[2*e] = u;
+	link_end[2*e+1] = *it;
+	link_slot[2*e] = s;
+	smaller_link[fill[*it]++] = e;
+	++e;
+      }
+      else smaller_slots.push_back(make_pair(*it, s));
+    }
+
+    sort(smaller_slots.begin(), smaller_slots.end());
+    for (size_t j = 0; j < smaller_slots.size(); ++j)
+      link_slot[2 * smaller_link[smaller_start[u] + j] + 1] = smaller_slots[j].second;
+  }
+
+  order.resize(num_links);
+  for (Offset l = 0; l < num_links; ++l) order[l] = l;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * Shuffles the failure order, Fisher-Yates with srand()
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+inline void Bond_links<Vertex, Offset>::random_order()
+{
+  for (Offset i = order.size(); i > 1; --i)
+    swap(order[i-1], order[random_node_index(i)]);
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param live degree of every node
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+template <class Degrees>
+inline void Bond_links<Vertex, Offset>::reset(Flat_graph_t<Vertex, Offset> &net, Degrees &degree)
+{
+  reset_live_degree(net, degree);
+  slot_present.assign(slot_present.size(), 1);
+  num_failed = 0;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param number of failed links wanted, not below get_num_failed()
+ * @param graph snapshot
+ * @param live degree of every node
+ * @param bitmask to store the nodes left below their threshold, for bond_network_prune
+ * A failed link lowers the degree of its end nodes if both are live, as when the link
+ * is removed with one of its nodes
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+template <class Degrees>
+inline void Bond_links<Vertex, Offset>::fail_links(Offset num_total, Flat_graph_t<Vertex, Offset> &net,
+						   Degrees &degree, vector<uint64_t> &candidates)
+{
+  const int *threshold = net.threshold_data();
+  candidates.assign((size_t(net.get_num_vertices()) + 63) / 64, 0);
+
+  for (; num_failed < num_total; ++num_failed) {
+
+    Offset e = order[num_failed];
+    slot_present[link_slot[2*e]] = 0;
+    slot_present[link_slot[2*e+1]] = 0;
+
+    Vertex u = link_end[2*e], v = link_end[2*e+1];
+    if (degree[u] <= 0 || degree[v] <= 0) continue;
+
+    --degree[u];
+    --degree[v];
+
+    if (degree[u] > 0 && degree[u] < threshold[u]) candidates[u / 64] |= uint64_t(1) << (u % 64);
+    if (degree[v] > 0 && degree[v] < threshold[v]) candidates[v / 64] |= uint64_t(1) << (v % 64);
+  }
+}
+
+
+#endif
@@ -0,0 +1,503 @@
+/*-------------------------------------------------------------------------------
+ * Contains Compressed_graph class
+ * Compressed_graph is a read-only snapshot like Flat_graph (flat_graph.hpp) with the
+ * neighbor lists compressed, for networks whose adjacency array does not fit in memory
+ * The neighbors of every node are sorted and stored as differences in a varint byte
+ * stream: the first neighbor relative to the node itself (zigzag for the sign), every
+ * further neighbor as the gap to the one before, 7 bits per byte and the high bit set
+ * while more bytes follow
+ * Random links of N nodes cost about log2(N/k)/7 bytes, relabeled snapshots with
+ * nearby neighbors (net_reorder.hpp) mostly 1 byte per link end
+ * Neighbors are decoded while the iterator advances, so the functions of net_ops_flat.hpp
+ * run on a compressed snapshot unchanged and give the same results as on the snapshot
+ * it was made from, only the order neighbors are visited in within a block differs
+ * A snapshot is made from a flat snapshot, or streamed from links given again and again
+ * by a function (a link list, the configuration model of net_config_model.hpp or the
+ * network of net_deterministic.hpp), one range of nodes at a time, so the links of all
+ * the nodes are never held uncompressed
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+
+#ifndef NET_COMPRESSED_HPP
+#define NET_COMPRESSED_HPP
+
+
+/*-----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <algorithm>
+
+#include "flat_graph.hpp"
+
+/*-----------------------------------------------------------------------------*/
+
+
+// Link ends held uncompressed at once by a streamed build, 256 MB of 32 bit nodes
+const size_t compressed_range_ends = size_t(1) << 26;
+
+
+/*-------------------------------------------------------------------------------
+ * Links of a list with the 2 end nodes of every link, as a function that gives every
+ * link to f(u, v), for the streamed build of Compressed_graph_t
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex>
+struct Link_list {
+
+  const Vertex *link_ends;
+  size_t num_links;
+
+  template <class Function>
+  void operator()(Function f) const {
+    for (size_t e = 0; e < num_links; ++e) f(link_ends[2*e], link_ends[2*e+1]);
+  }
+};
+
+
+/*-------------------------------------------------------------------------------
+ * @param position of a varint in the byte stream
+ * @param value to store the decoded number
+ * @Returns position after the varint
+-------------------------------------------------------------------------------*/
+
+
+inline const uint8_t * read_varint(const uint8_t *pos, uint64_t &value)
+{
+  uint64_t byte = *pos++;
+  value = byte & 0x7f;
+
+  for (int shift = 7; byte & 0x80; shift += 7) {
+    byte = *pos++;
+    value |= (byte & 0x7f) << shift;
+  }
+
+  return pos;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param number to be encoded
+ * @param byte stream to write to, NULL only counts the bytes
+ * @Returns number of bytes of the varint
+-------------------------------------------------------------------------------*/
+
+
+inline int write_varint(uint64_t value, uint8_t *pos)
+{
+  int num_bytes = 1;
+  for (; value >= 0x80; value >>= 7, ++num_bytes)
+    if (pos) *pos++ = uint8_t(value) | 0x80;
+
+  if (pos) *pos = uint8_t(value);
+  return num_bytes;
+}
+
+
+template <class Vertex = int, class Offset = long>
+class Compressed_graph_t {
+
+protected:
+
+  // offsets[i] .. offsets[i+1] is the byte range of node i in the neighbor stream
+  vector<Offset> offsets;
+
+
+  // Varint differences of the sorted neighbors of all the nodes, one after another,
+  // and one zero byte read when an iterator steps past the last neighbor
+  vector<uint8_t> stream;
+
+
+  // Degree, local kcore threshold and labels as in Flat_graph_t
+  vector<int> degrees;
+  vector<int> thresholds;
+  vector<Vertex> labels;
+  vector<Vertex> original_index;
+
+
+  // Encodes the sorted neighbors of a node, NULL only counts the bytes
+  static Offset encode_block(Vertex idx_vertex, const Vertex *block, size_t num_neighbors, uint8_t *pos);
+
+
+  // Sorted distinct neighbors of a range of nodes, uncompressed, for the streamed build
+  template <class Link_source>
+  void fill_range(Vertex first, Vertex last, Link_source &links, const vector<int> &num_link_ends,
+		  vector<Offset> &block_start, vector<Vertex> &ends);
+
+
+public:
+
+  typedef Vertex vertex_type;
+  typedef Offset offset_type;
+
+
+  // Compresses the neighbor blocks of a flat snapshot, labels and thresholds are copied
+  template <class Flat_vertex, class Flat_offset>
+  void build_from(Flat_graph_t<Flat_vertex, Flat_offset> &net);
+
+
+  // Streamed build, links(f) gives every link to f(u, v), the same links at every call,
+  // self-loops are dropped and multiple links merged, thresholds set to 0
+  template <class Link_source>
+  void build_from_link_source(Vertex num_nodes, Link_source links, size_t max_range_ends = compressed_range_ends);
+
+
+  // Streamed build from pairs of end nodes, as build_from_links of Flat_graph_t
+  void build_from_links(Vertex num_nodes, size_t num_links, const Vertex *link_ends,
+			size_t max_range_ends = compressed_range_ends) {
+    Link_list<Vertex> list = {link_ends, num_links};
+    build_from_link_source(num_nodes, list, max_range_ends);
+  }
+
+
+  // Conversion between index in the built network and index in the snapshot
+  bool is_relabeled() { return !labels.empty(); }
+  Vertex get_label(Vertex original_idx) { return labels.empty() ? original_idx : labels[original_idx]; }
+  Vertex get_original_index(Vertex idx_vertex) { return original_index.empty() ? idx_vertex : original_index[idx_vertex]; }
+  const Vertex * label_data() { return labels.data(); }
+  const Vertex * original_index_data() { return original_index.data(); }
+
+
+  // Returns the size of the network
+  Vertex size() { return degrees.size(); }
+  Vertex get_num_vertices() { return degrees.size(); }
+  Offset get_num_edges();
+
+
+  // Bytes held by the snapshot, and by the neighbor blocks with their offsets only
+  size_t memory_bytes();
+  size_t adjacency_bytes() { return offsets.size() * sizeof(Offset) + stream.size(); }
+
+
+  // Calls f(data, bytes) for every array, used to place the snapshot in memory (net_placement.hpp)
+  template <class Function> void visit_arrays(Function f) {
+    f(offsets.data(), offsets.size() * sizeof(Offset));
+    f(stream.data(), stream.size());
+    f(degrees.data(), degrees.size() * sizeof(int));
+    f(thresholds.data(), thresholds.size() * sizeof(int));
+    f(labels.data(), labels.size() * sizeof(Vertex));
+    f(original_index.data(), original_index.size() * sizeof(Vertex));
+  }
+
+
+  // Single node functions
+  int get_deg_vertex(Vertex idx_vertex) { return degrees[idx_vertex]; }
+  int get_threshold(Vertex idx_vertex) { return thresholds[idx_vertex]; }
+  void set_threshold(Vertex idx_vertex, int threshold_inp) { thresholds[idx_vertex] = threshold_inp; }
+
+
+  // Check if two nodes are linked, decodes the block of node1 up to node2
+  bool connection_check(Vertex node1, Vertex node2);
+
+
+  // Contiguous arrays used by the vectorized kernels
+  const int * threshold_data() { return thresholds.data(); }
+  const vector<int> & initial_degrees() { return degrees; }
+
+
+  /*-------------------------------------------------------------------------------
+   * Decodes one neighbor per step, pos is the start of the varint of the current
+   * neighbor and next the one after, iterators compare by position only
+   * A step past the last neighbor decodes the first varint of the next block, or the
+   * zero byte at the end of the stream, the value is never read
+  -------------------------------------------------------------------------------*/
+
+
+  class node_neighbor_iterator {
+
+  protected:
+
+    const uint8_t *pos, *next;
+    Vertex value;
+
+  public:
+
+    node_neighbor_iterator() : pos(0), next(0), value(0) {}
+
+    // End of a block
+    node_neighbor_iterator(const uint8_t *pos_inp) : pos(pos_inp), next(pos_inp), value(0) {}
+
+    // First neighbor of node idx_vertex in a block that is not empty
+    node_neighbor_iterator(const uint8_t *pos_inp, Vertex idx_vertex) : pos(pos_inp) {
+      uint64_t zigzag;
+      next = read_varint(pos, zigzag);
+      value = Vertex(int64_t(idx_vertex) + (int64_t(zigzag >> 1) ^ -int64_t(zigzag & 1)));
+    }
+
+    Vertex operator*() const { return value; }
+
+    node_neighbor_iterator & operator++() {
+      uint64_t gap;
+      pos = next;
+      next = read_varint(pos, gap);
+      value += Vertex(gap);
+      return *this;
+    }
+
+    bool operator!=(const node_neighbor_iterator &other) const { return pos != other.pos; }
+    bool operator==(const node_neighbor_iterator &other) const { return pos == other.pos; }
+  };
+
+
+  node_neighbor_iterator vertex_neighbor_begin(size_t index) {
+    if (offsets[index] == offsets[index+1]) return node_neighbor_iterator(stream.data() + offsets[index]);
+    return node_neighbor_iterator(stream.data() + offsets[index], Vertex(index)); }
+  node_neighbor_iterator vertex_neighbor_end(size_t index) {
+    return node_neighbor_iterator(stream.data() + offsets[index+1]); }
+
+
+  // Constructors
+  Compressed_graph_t() {
+    offsets.assign(1, 0);
+  }
+
+  template <class Flat_vertex, class Flat_offset>
+  Compressed_graph_t(Flat_graph_t<Flat_vertex, Flat_offset> &net) {
+    build_from(net);
+  }
+};
+
+
+// Compressed snapshot with the index types of the list based graph
+typedef Compressed_graph_t<> Compressed_graph;
+
+
+//------------------------------Member function definitions----------------------
+
+
+/*-------------------------------------------------------------------------------
+ * @param integer index of the node
+ * @param sorted neighbors of the node and their number
+ * @param byte stream to write the block to, NULL only counts the bytes
+ * @Returns number of bytes of the block
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+inline Offset Compressed_graph_t<Vertex, Offset>::encode_block(Vertex idx_vertex, const Vertex *block,
+							       size_t num_neighbors, uint8_t *pos)
+{
+  Offset num_bytes = 0;
+
+  for (size_t j = 0; j < num_neighbors; ++j) {
+
+    uint64_t code;
+    if (j == 0) {
+      int64_t diff = int64_t(block[0]) - int64_t(idx_vertex);
+      code = (uint64_t(diff) << 1) ^ uint64_t(diff >> 63);
+    }
+    else code = uint64_t(block[j] - block[j-1]);
+
+    num_bytes += write_varint(code, pos ? pos + num_bytes : 0);
+  }
+
+  return num_bytes;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param flat snapshot
+ * Sizes of the blocks are counted first so the stream is allocated only once,
+ * every block is sorted twice in a copy, the flat snapshot is not changed
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+template <class Flat_vertex, class Flat_offset>
+inline void Compressed_graph_t<Vertex, Offset>::build_from(Flat_graph_t<Flat_vertex, Flat_offset> &net)
+{
+  Vertex num_nodes = net.get_num_vertices();
+  vector<Vertex> block;
+
+  offsets.resize(num_nodes + 1);
+  degrees.resize(num_nodes);
+  thresholds.assign(net.threshold_data(), net.threshold_data() + num_nodes);
+
+  offsets[0] = 0;
+  for (int pass = 0; pass < 2; ++pass) {
+
+    if (pass == 1) {
+      stream.assign(offsets[num_nodes] + 1, 0);
+      stream.shrink_to_fit();
+    }
+
+    for (Vertex i = 0; i < num_nodes; ++i) {
+      block.assign(net.vertex_neighbor_begin(i), net.vertex_neighbor_end(i));
+      sort(block.begin(), block.end());
+
+      if (pass == 0) {
+	degrees[i] = block.size();
+	offsets[i+1] = offsets[i] + encode_block(i, block.data(), block.size(), 0);
+      }
+      else encode_block(i, block.data(), block.size(), stream.data() + offsets[i]);
+    }
+  }
+
+  labels.clear();
+  original_index.clear();
+  if (net.is_relabeled()) {
+    labels.assign(net.label_data(), net.label_data() + num_nodes);
+    original_index.assign(net.original_index_data(), net.original_index_data() + num_nodes);
+  }
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param number of nodes
+ * @param function giving every link to f(u, v), the same links in every call
+ * @param largest number of link ends of a range of nodes held uncompressed
+ * Nodes are split in ranges of at most max_range_ends link ends (one node at least),
+ * the links are given once to count the link ends of every node, once per range to
+ * count the bytes of its blocks, and once per range but the last to encode them, so
+ * the stream is allocated only once at its final size
+ * Memory besides the snapshot is one range of link ends and one int per node
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+template <class Link_source>
+inline void Compressed_graph_t<Vertex, Offset>::build_from_link_source(Vertex num_nodes, Link_source links,
+								       size_t max_range_ends)
+{
+  // Arrays of an earlier snapshot are freed first
+  vector<uint8_t>().swap(stream);
+  labels.clear();
+  original_index.clear();
+
+  offsets.assign(num_nodes + 1, 0);
+  degrees.assign(num_nodes, 0);
+  thresholds.assign(num_nodes, 0);
+
+  vector<int> num_link_ends(num_nodes, 0);
+  links([&](Vertex u, Vertex v) {
+      if (u == v) return;
+      ++num_link_ends[u];
+      ++num_link_ends[v];
+    });
+
+
+  // First node of every range, and the number of nodes at the end
+  vector<Vertex> range_first(1, 0);
+  size_t range_ends = 0;
+  for (Vertex i = 0; i < num_nodes; ++i) {
+    if (range_ends + num_link_ends[i] > max_range_ends && i > range_first.back()) {
+      range_first.push_back(i);
+      range_ends = 0;
+    }
+    range_ends += num_link_ends[i];
+  }
+  range_first.push_back(num_nodes);
+  int num_ranges = range_first.size() - 1;
+
+  vector<Offset> block_start;
+  vector<Vertex> ends;
+
+  for (int r = 0; r < num_ranges; ++r) {
+    fill_range(range_first[r], range_first[r+1], links, num_link_ends, block_start, ends);
+
+    for (Vertex i = range_first[r]; i < range_first[r+1]; ++i)
+      offsets[i+1] = offsets[i] + encode_block(i, ends.data() + block_start[i - range_first[r]], degrees[i], 0);
+  }
+
+  stream.assign(offsets[num_nodes] + 1, 0);
+  stream.shrink_to_fit();
+
+
+  // Last range first, its blocks are still filled
+  for (int r = num_ranges - 1; r >= 0; --r) {
+    if (r < num_ranges - 1)
+      fill_range(range_first[r], range_first[r+1], links, num_link_ends, block_start, ends);
+
+    for (Vertex i = range_first[r]; i < range_first[r+1]; ++i)
+      encode_block(i, ends.data() + block_start[i - range_first[r]], degrees[i], stream.data() + offsets[i]);
+  }
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param first node and node after the last of the range
+ * @param function giving every link
+ * @param number of link ends of every node, self-loops not counted
+ * @param vector to store the start of the block of every node of the range in ends
+ * @param vector to store the neighbors of the nodes of the range
+ * Blocks are sorted and multiple links merged, the degree of every node is set
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+template <class Link_source>
+inline void Compressed_graph_t<Vertex, Offset>::fill_range(Vertex first, Vertex last, Link_source &links,
+							   const vector<int> &num_link_ends,
+							   vector<Offset> &block_start, vector<Vertex> &ends)
+{
+  block_start.assign(last - first + 1, 0);
+  for (Vertex i = first; i < last; ++i) block_start[i - first + 1] = block_start[i - first] + num_link_ends[i];
+
+  ends.resize(block_start[last - first]);
+  vector<Offset> fill(block_start.begin(), block_start.end() - 1);
+
+  links([&](Vertex u, Vertex v) {
+      if (u == v) return;
+      if (u >= first && u < last) ends[fill[u - first]++] = v;
+      if (v >= first && v < last) ends[fill[v - first]++] = u;
+    });
+
+  for (Vertex i = first; i < last; ++i) {
+    Vertex *block = ends.data() + block_start[i - first];
+    Vertex *block_end = ends.data() + block_start[i - first + 1];
+    sort(block, block_end);
+    degrees[i] = unique(block, block_end) - block;
+  }
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param two integer indices for two nodes
+ * @Returns true if they are linked
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+inline bool Compressed_graph_t<Vertex, Offset>::connection_check(Vertex node1, Vertex node2)
+{
+  node_neighbor_iterator it;
+  for (it = vertex_neighbor_begin(node1); it != vertex_neighbor_end(node1); ++it)
+    if (*it >= node2) return *it == node2;
+
+  return false;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @Returns the number of links in the graph
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+inline Offset Compressed_graph_t<Vertex, Offset>::get_num_edges()
+{
+  Offset num_ends = 0;
+  for (size_t i = 0; i < degrees.size(); ++i) num_ends += degrees[i];
+
+  return num_ends / 2;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @Returns the number of bytes of the arrays of the snapshot
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+inline size_t Compressed_graph_t<Vertex, Offset>::memory_bytes()
+{
+  return adjacency_bytes() + (degrees.size() + thresholds.size()) * sizeof(int)
+    + (labels.size() + original_index.size()) * sizeof(Vertex);
+}
+
+
+#endif
@@ -0,0 +1,428 @@
+/*-------------------------------------------------------------------------------
+ * Configuration model networks built directly into a Flat_graph snapshot
+ * 1. Degree sequences: Poisson, power law and bimodal distributions, or read from a file
+ * 2. Stubs (one per link end) are shuffled in parallel and paired in order
+ * 3. Self-loops are dropped and multiple links merged (erased configuration model)
+ * Random numbers come from Rng_stream, one stream per fixed chunk of work, so the
+ * network depends on the seed only and not on the number of threads
+ * Any snapshot index types can be built, see select_index_width in flat_graph.hpp
+ * A Compressed_graph (net_compressed.hpp) is built from the shuffled stubs directly,
+ * without the uncompressed neighbor blocks of all the nodes
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+
+#ifndef NET_CONFIG_MODEL_HPP
+#define NET_CONFIG_MODEL_HPP
+
+
+/*-----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <fstream>
+
+#include <algorithm>
+
+#include <cmath>
+
+#include "./statool/prng.hpp"
+
+#include "flat_graph.hpp"
+
+#include "net_compressed.hpp"
+
+#include "net_parallel.hpp"
+
+/*-----------------------------------------------------------------------------*/
+
+
+// Number of chunks of work, each with its own random number stream
+const int config_model_chunks = 256;
+
+
+// Degree distributions understood by degree_distribution_cdf
+enum Degree_distribution { degrees_poisson, degrees_power_law, degrees_bimodal };
+
+
+/*-------------------------------------------------------------------------------
+ * @param number of items
+ * @param chunk index
+ * @Returns first item of the chunk, the chunk ends at the first item of the next
+-------------------------------------------------------------------------------*/
+
+
+inline long chunk_begin(long num_items, int chunk)
+{
+  return num_items * chunk / config_model_chunks;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param cumulative distribution, cdf[k] is the probability of degree <= k
+ * @param number of nodes
+ * @param seed of the random number streams
+ * @param vector to store the degree of every node
+ * @param number of threads, 0 for the number of hardware threads
+ * Inverse transform sampling with a binary search in the cumulative distribution
+-------------------------------------------------------------------------------*/
+
+
+inline void sample_degrees(const vector<double> &cdf, long num_nodes, uint64_t seed, vector<int> &degree,
+			   int num_threads = 0)
+{
+  degree.resize(num_nodes);
+
+  parallel_for(config_model_chunks, num_threads, [&](int c) {
+      Rng_stream rng(seed, c);
+      for (long i = chunk_begin(num_nodes, c); i < chunk_begin(num_nodes, c + 1); ++i) {
+	long k = upper_bound(cdf.begin(), cdf.end(), rng.next()) - cdf.begin();
+	degree[i] = k < long(cdf.size()) ? k : cdf.size() - 1;
+      }
+    });
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param distribution
+ * @param average degree (Poisson)
+ * @param exponent gamma of P(k) ~ k^-gamma (power law)
+ * @param smallest and largest degree (power law), low and high degree (bimodal)
+ * @param fraction of nodes with the low degree (bimodal)
+ * @param vector to store the cumulative distribution up to the largest degree
+ * The Poisson distribution is cut where the rest of the tail is below 1e-16
+-------------------------------------------------------------------------------*/
+
+
+inline void degree_distribution_cdf(Degree_distribution distribution, double avg_degree, double gamma,
+				    int k_low, int k_high, double frac_low, vector<double> &cdf)
+{
+  vector<double> pk;
+
+  switch (distribution) {
+
+  case degrees_poisson: {
+    double term = exp(-avg_degree), sum = 0.0;
+    for (int k = 0; sum < 1.0 - 1e-16 && k < 10 * avg_degree + 100; ++k) {
+      pk.push_back(term);
+      sum += term;
+      term *= avg_degree / (k + 1);
+    }
+    break;
+  }
+
+  case degrees_power_law:
+    pk.assign(k_high + 1, 0.0);
+    for (int k = k_low; k <= k_high; ++k) pk[k] = pow(double(k), -gamma);
+    break;
+
+  case degrees_bimodal:
+    pk.assign(k_high + 1, 0.0);
+    pk[k_low] += frac_low;
+    pk[k_high] += 1.0 - frac_low;
+    break;
+  }
+
+  double total = 0.0;
+  for (size_t k = 0; k < pk.size(); ++k) total += pk[k];
+
+  cdf.resize(pk.size());
+  double sum = 0.0;
+  for (size_t k = 0; k < pk.size(); ++k) {
+    sum += pk[k];
+    cdf[k] = sum / total;
+  }
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param name of a file with the degree of one node per line
+ * @param vector to store the degree of every node
+ * @return false if the file could not be read or holds a negative degree
+-------------------------------------------------------------------------------*/
+
+
+inline bool read_degree_sequence(const char *file_name, vector<int> &degree)
+{
+  ifstream degree_in(file_name);
+  if (!degree_in) return false;
+
+  degree.clear();
+  int k;
+  while (degree_in >> k) {
+    if (k < 0) return false;
+    degree.push_back(k);
+  }
+
+  return !degree.empty();
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param degree of every node
+ * Every link has two ends, an odd sum is made even by changing the first node by one
+-------------------------------------------------------------------------------*/
+
+
+inline void make_degree_sum_even(vector<int> &degree)
+{
+  long sum = 0;
+  for (size_t i = 0; i < degree.size(); ++i) sum += degree[i];
+
+  if (sum % 2 && !degree.empty()) degree[0] += degree[0] > 0 ? -1 : 1;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param stubs, the index of a node once for every link end of the node
+ * @param seed of the random number streams
+ * @param number of threads
+ * Uniform random permutation in three parallel steps: every stub picks a random bucket,
+ * stubs are moved to their buckets, every bucket is shuffled (Fisher-Yates)
+ * Chunks of stubs and buckets each draw from their own stream
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex>
+inline void shuffle_stubs(vector<Vertex> &stubs, uint64_t seed, int num_threads)
+{
+  const int num_buckets = config_model_chunks;
+  long num_stubs = stubs.size();
+
+  vector<unsigned char> bucket_of(num_stubs);
+  vector<long> count(long(config_model_chunks) * num_buckets, 0);
+
+  parallel_for(config_model_chunks, num_threads, [&](int c) {
+      Rng_stream rng(seed, c);
+      long *chunk_count = &count[long(c) * num_buckets];
+      for (long s = chunk_begin(num_stubs, c); s < chunk_begin(num_stubs, c + 1); ++s) {
+	int b = int(rng.next() * num_buckets);
+	bucket_of[s] = b;
+	++chunk_count[b];
+      }
+    });
+
+  // Buckets one after another, within a bucket the stubs of chunk 0 first
+  vector<long> bucket_start(num_buckets + 1, 0);
+  long pos = 0;
+  for (int b = 0; b < num_buckets; ++b) {
+    bucket_start[b] = pos;
+    for (int c = 0; c < config_model_chunks; ++c) {
+      long n = count[long(c) * num_buckets + b];
+      count[long(c) * num_buckets + b] = pos;
+      pos += n;
+    }
+  }
+  bucket_start[num_buckets] = pos;
+
+  vector<Vertex> scattered(num_stubs);
+
+  parallel_for(config_model_chunks, num_threads, [&](int c) {
+      long *chunk_pos = &count[long(c) * num_buckets];
+      for (long s = chunk_begin(num_stubs, c); s < chunk_begin(num_stubs, c + 1); ++s)
+	scattered[chunk_pos[bucket_of[s]]++] = stubs[s];
+    });
+
+  parallel_for(num_buckets, num_threads, [&](int b) {
+      Rng_stream rng(seed, config_model_chunks + b);
+      Vertex *first = scattered.data() + bucket_start[b];
+      for (long i = bucket_start[b+1] - bucket_start[b] - 1; i > 0; --i)
+	swap(first[i], first[long(rng.next() * (i + 1))]);
+    });
+
+  stubs.swap(scattered);
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param degree of every node
+ * @param seed of the random number streams
+ * @param vector to store the stubs in random order
+ * @param number of threads
+ * Stubs of every node in node order, then shuffled
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex>
+inline void shuffled_stubs(const vector<int> &degree, uint64_t seed, vector<Vertex> &stubs, int num_threads)
+{
+  Vertex num_nodes = degree.size();
+
+  vector<long> first_stub(num_nodes + 1, 0);
+  for (Vertex i = 0; i < num_nodes; ++i) first_stub[i+1] = first_stub[i] + degree[i];
+
+  stubs.resize(first_stub[num_nodes]);
+  parallel_for(config_model_chunks, num_threads, [&](int c) {
+      for (long i = chunk_begin(num_nodes, c); i < chunk_begin(num_nodes, c + 1); ++i)
+	for (long s = first_stub[i]; s < first_stub[i+1]; ++s) stubs[s] = i;
+    });
+
+  shuffle_stubs(stubs, seed, num_threads);
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param degree of every node, with an even sum
+ * @param seed of the random number streams
+ * @param graph snapshot to build, thresholds set to 0
+ * @param number of threads, 0 for the number of hardware threads
+ * Pairs shuffled stubs two by two into links, drops self-loops and keeps one link of
+ * every multiple link, so hubs may end with a slightly smaller degree
+ * Neighbor blocks are sorted
+ * @return number of stub pairs that were dropped
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+inline long configuration_model(const vector<int> &degree, uint64_t seed, Flat_graph_t<Vertex, Offset> &net,
+				int num_threads = 0)
+{
+  Vertex num_nodes = degree.size();
+
+  vector<Vertex> stubs;
+  shuffled_stubs(degree, seed, stubs, num_threads);
+
+  long num_pairs = stubs.size() / 2;
+
+
+  // Link ends (node, neighbor) grouped by the range of nodes they belong to, so the
+  // neighbor blocks are filled one range at a time without atomic operations
+  const int num_ranges = config_model_chunks;
+  vector<long> range_count(long(config_model_chunks) * num_ranges, 0);
+
+  auto range_of = [num_nodes](Vertex u) { return int(uint64_t(u) * num_ranges / num_nodes); };
+
+  parallel_for(config_model_chunks, num_threads, [&](int c) {
+      long *chunk_count = &range_count[long(c) * num_ranges];
+      for (long e = chunk_begin(num_pairs, c); e < chunk_begin(num_pairs, c + 1); ++e) {
+	Vertex u = stubs[2*e], v = stubs[2*e+1];
+	if (u == v) continue;
+	++chunk_count[range_of(u)];
+	++chunk_count[range_of(v)];
+      }
+    });
+
+  vector<long> range_start(num_ranges + 1, 0);
+  long pos = 0;
+  for (int r = 0; r < num_ranges; ++r) {
+    range_start[r] = pos;
+    for (int c = 0; c < config_model_chunks; ++c) {
+      long n = range_count[long(c) * num_ranges + r];
+      range_count[long(c) * num_ranges + r] = pos;
+      pos += n;
+    }
+  }
+  range_start[num_ranges] = pos;
+
+  // Link end (node, neighbor)
+  vector<pair<Vertex, Vertex> > ends(pos);
+
+  parallel_for(config_model_chunks, num_threads, [&](int c) {
+      long *chunk_pos = &range_count[long(c) * num_ranges];
+      for (long e = chunk_begin(num_pairs, c); e < chunk_begin(num_pairs, c + 1); ++e) {
+	Vertex u = stubs[2*e], v = stubs[2*e+1];
+	if (u == v) continue;
+	ends[chunk_pos[range_of(u)]++] = make_pair(u, v);
+	ends[chunk_pos[range_of(v)]++] = make_pair(v, u);
+      }
+    });
+
+  vector<Vertex>().swap(stubs);
+
+
+  // Count and fill the neighbor blocks of every range of nodes
+  vector<int> num_ends(num_nodes, 0);
+  parallel_for(num_ranges, num_threads, [&](int r) {
+      for (long e = range_start[r]; e < range_start[r+1]; ++e) ++num_ends[ends[e].first];
+    });
+
+  vector<Offset> offsets(num_nodes + 1, 0);
+  for (Vertex i = 0; i < num_nodes; ++i) offsets[i+1] = offsets[i] + num_ends[i];
+
+  vector<Vertex> adjacency(offsets[num_nodes]);
+  vector<Offset> fill(offsets.begin(), offsets.end() - 1);
+
+  parallel_for(num_ranges, num_threads, [&](int r) {
+      for (long e = range_start[r]; e < range_start[r+1]; ++e)
+	adjacency[fill[ends[e].first]++] = ends[e].second;
+    });
+
+  vector<pair<Vertex, Vertex> >().swap(ends);
+
+
+  // Sort every block and merge multiple links
+  parallel_for(config_model_chunks, num_threads, [&](int c) {
+      for (long i = chunk_begin(num_nodes, c); i < chunk_begin(num_nodes, c + 1); ++i) {
+	Vertex *first = adjacency.data() + offsets[i];
+	Vertex *last = adjacency.data() + offsets[i+1];
+	sort(first, last);
+	num_ends[i] = unique(first, last) - first;
+      }
+    });
+
+  vector<Offset> new_offsets(num_nodes + 1, 0);
+  for (Vertex i = 0; i < num_nodes; ++i) new_offsets[i+1] = new_offsets[i] + num_ends[i];
+
+  vector<Vertex> new_adjacency(new_offsets[num_nodes]);
+  parallel_for(config_model_chunks, num_threads, [&](int c) {
+      for (long i = chunk_begin(num_nodes, c); i < chunk_begin(num_nodes, c + 1); ++i)
+	copy(adjacency.begin() + offsets[i], adjacency.begin() + offsets[i] + num_ends[i],
+	     new_adjacency.begin() + new_offsets[i]);
+    });
+
+  net.build_from_adjacency(new_offsets, new_adjacency);
+
+  return num_pairs - net.get_num_edges();
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param degree of every node, with an even sum
+ * @param seed of the random number streams
+ * @param compressed snapshot to build, thresholds set to 0
+ * @param number of threads of the shuffle, 0 for the number of hardware threads
+ * @param largest number of link ends held uncompressed, see build_from_link_source
+ * Same links as the flat snapshot of configuration_model above, streamed from the
+ * shuffled stubs, which are the only array with one entry per link end
+ * @return number of stub pairs that were dropped
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+inline long configuration_model(const vector<int> &degree, uint64_t seed, Compressed_graph_t<Vertex, Offset> &net,
+				int num_threads = 0, size_t max_range_ends = compressed_range_ends)
+{
+  vector<Vertex> stubs;
+  shuffled_stubs(degree, seed, stubs, num_threads);
+
+  long num_pairs = stubs.size() / 2;
+
+  // Stubs 2e and 2e+1 are the ends of link e
+  Link_list<Vertex> stub_pairs = {stubs.data(), size_t(num_pairs)};
+  net.build_from_link_source(Vertex(degree.size()), stub_pairs, max_range_ends);
+
+  return num_pairs - net.get_num_edges();
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @params threshold values and the probability of the first one
+ * Same random choices as set_init_threshold_frac for a list based graph
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+inline void set_init_threshold_frac(Flat_graph_t<Vertex, Offset> &net, int threshold1, double prob_thresh1,
+				    int threshold2, double prob_thresh2)
+{
+  Vertex num_nodes = net.get_num_vertices();
+
+  for (Vertex i = 0; i < num_nodes; i++)
+    net.set_threshold(i, srand() < prob_thresh1 ? threshold1 : threshold2);
+}
+
+
+#endif
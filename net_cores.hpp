@@ -0,0 +1,181 @@
+/*-------------------------------------------------------------------------------
+ * Core decomposition of a Flat_graph snapshot
+ * 1. Core number of every node in linear time (Batagelj-Zaversnik bucket order)
+ * 2. Biggest cluster of every k-core from the core numbers, one union-find pass
+ * For a threshold k shared by all nodes, network_prune leaves exactly the nodes with
+ * core number >= k, so one decomposition answers every uniform threshold at once
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+
+#ifndef NET_CORES_HPP
+#define NET_CORES_HPP
+
+
+/*-----------------------------------------------------------------------------*/
+
+#include <vector>
+
+#include "flat_graph.hpp"
+
+/*-----------------------------------------------------------------------------*/
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param live degree of every node
+ * @param vector to store the core number of every node, 0 for removed nodes
+ * Nodes are kept in buckets of their current degree and taken out lowest first,
+ * a live neighbor with higher current degree moves one bucket down
+ * @return largest core number
+-------------------------------------------------------------------------------*/
+
+
+inline int core_numbers(Flat_graph &net, const vector<int> &degree, vector<int> &core)
+{
+  int num_nodes = net.get_num_vertices();
+
+  int max_degree = 0;
+  for (int i = 0; i < num_nodes; ++i)
+    if (degree[i] > max_degree) max_degree = degree[i];
+
+  // core holds the current degree until the node is taken out
+  core = degree;
+
+  // bucket_start[d] is the position of the first node of degree d in order
+  vector<int> bucket_start(max_degree + 2, 0);
+  for (int i = 0; i < num_nodes; ++i) ++bucket_start[core[i] + 1];
+  for (int d = 1; d <= max_degree + 1; ++d) bucket_start[d] += bucket_start[d-1];
+
+  vector<int> order(num_nodes), position(num_nodes);
+  {
+    vector<int> next_pos(bucket_start.begin(), bucket_start.end() - 1);
+    for (int i = 0; i < num_nodes; ++i) {
+      position[i] = next_pos[core[i]]++;
+      order[position[i]] = i;
+    }
+  }
+
+  Flat_graph::node_neighbor_iterator it;
+
+  for (int pos = 0; pos < num_nodes; ++pos) {
+
+    int v = order[pos];
+
+    // Removed nodes keep their links in the snapshot, but none of them is live
+    if (degree[v] == 0) continue;
+
+    for (it = net.vertex_neighbor_begin(v); it != net.vertex_neighbor_end(v); ++it) {
+      int u = *it;
+
+      // Removed nodes have core number 0 and are never moved
+      if (core[u] <= core[v]) continue;
+
+      // Swap u with the first node of its bucket, then shrink the bucket from the front
+      int du = core[u];
+      int pos_u = position[u], pos_w = bucket_start[du];
+      int w = order[pos_w];
+      if (u != w) {
+	order[pos_u] = w; position[w] = pos_u;
+	order[pos_w] = u; position[u] = pos_w;
+      }
+      ++bucket_start[du];
+      --core[u];
+    }
+  }
+
+  int max_core = 0;
+  for (int i = 0; i < num_nodes; ++i)
+    if (core[i] > max_core) max_core = core[i];
+
+  return max_core;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param vector of union-find parents
+ * @param integer index of the node
+ * @Returns root of the set of the node, halving the path on the way
+-------------------------------------------------------------------------------*/
+
+
+inline int find_root(vector<int> &parent, int node_idx)
+{
+  while (parent[node_idx] != node_idx) {
+    parent[node_idx] = parent[parent[node_idx]];
+    node_idx = parent[node_idx];
+  }
+  return node_idx;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param core number of every node
+ * @param largest threshold of interest
+ * @param vector to store the biggest cluster size of the k-core for k = 0 .. k_max
+ * Nodes are added from the highest core number down and joined with the neighbors
+ * already added, after core number k is added the clusters are those of the k-core
+ * Sizes count a node without live links as a cluster of its own, as find_biggest_cluster
+ * does, so an empty k-core has biggest cluster 1
+-------------------------------------------------------------------------------*/
+
+
+inline void biggest_kcore_clusters(Flat_graph &net, const vector<int> &core, int k_max, vector<long> &biggest_size)
+{
+  int num_nodes = net.get_num_vertices();
+
+  int max_core = 0;
+  for (int i = 0; i < num_nodes; ++i)
+    if (core[i] > max_core) max_core = core[i];
+
+  // Nodes sorted by decreasing core number
+  vector<int> first_of_core(max_core + 2, 0);
+  for (int i = 0; i < num_nodes; ++i) ++first_of_core[max_core - core[i] + 1];
+  for (int c = 1; c <= max_core + 1; ++c) first_of_core[c] += first_of_core[c-1];
+
+  vector<int> sorted_nodes(num_nodes);
+  {
+    vector<int> next_pos(first_of_core.begin(), first_of_core.end() - 1);
+    for (int i = 0; i < num_nodes; ++i) sorted_nodes[next_pos[max_core - core[i]]++] = i;
+  }
+
+  vector<int> parent(num_nodes), cluster_size(num_nodes, 1);
+  for (int i = 0; i < num_nodes; ++i) parent[i] = i;
+
+  biggest_size.assign(k_max + 1, 1);
+  long biggest = 1;
+
+  Flat_graph::node_neighbor_iterator it;
+
+  // Nodes with core number 0 have no live links and stay clusters of their own
+  for (int c = max_core; c >= 1; --c) {
+
+    // Nodes with core number c, joined with the neighbors of core number >= c
+    for (int s = first_of_core[max_core - c]; s < first_of_core[max_core - c + 1]; ++s) {
+
+      int v = sorted_nodes[s];
+
+      for (it = net.vertex_neighbor_begin(v); it != net.vertex_neighbor_end(v); ++it) {
+	int u = *it;
+	if (core[u] < c) continue;
+
+	int root_v = find_root(parent, v), root_u = find_root(parent, u);
+	if (root_v == root_u) continue;
+
+	// Union by size
+	if (cluster_size[root_v] < cluster_size[root_u]) swap(root_v, root_u);
+	parent[root_u] = root_v;
+	cluster_size[root_v] += cluster_size[root_u];
+	if (cluster_size[root_v] > biggest) biggest = cluster_size[root_v];
+      }
+    }
+
+    if (c <= k_max) biggest_size[c] = biggest;
+  }
+
+  biggest_size[0] = biggest;
+}
+
+
+#endif
@@ -0,0 +1,588 @@
+/*-------------------------------------------------------------------------------
+ * Random network, thresholds and attacks for runs on many threads
+ * Random numbers come from Rng_stream, one stream per fixed chunk of nodes or links
+ * (config_model_chunks) and per attack, never per thread, so a seed gives the same
+ * network, thresholds, attacks and output files with any number of threads
+ * 1. ER network with exactly N*avg_degree/2 links, as lt_ER_algo, into a flat or a
+ *    compressed snapshot
+ * 2. Random thresholds, as set_init_threshold_frac
+ * 3. Random attack of exactly int((1-p)N) nodes, as initial_random_attack
+ * 4. 64 random attacks of the bit parallel engine, one attack of 3. per realization
+ * 5. Ensemble averages summed in attack order
+ * The random choices follow the same distributions as the srand() functions but are
+ * different numbers, a run with these functions does not repeat a serial run
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+
+#ifndef NET_DETERMINISTIC_HPP
+#define NET_DETERMINISTIC_HPP
+
+
+/*-----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <set>
+
+#include <algorithm>
+
+#include <cmath>
+
+#include "./statool/prng.hpp"
+
+#include "flat_graph.hpp"
+
+#include "net_parallel.hpp"
+
+#include "net_config_model.hpp"
+
+#include "net_compressed.hpp"
+
+#include "net_bitpar.hpp"
+
+/*-----------------------------------------------------------------------------*/
+
+
+// Jobs drawing random numbers from the same seed, every job has its own streams
+enum Stream_job { job_links = 1, job_extra_links, job_thresholds, job_attack };
+
+
+/*-------------------------------------------------------------------------------
+ * @param seed of the run
+ * @param job
+ * @param index of the job, the attack number for job_attack
+ * @param chunk of work
+ * @Returns the random number stream of the chunk
+-------------------------------------------------------------------------------*/
+
+
+inline Rng_stream job_stream(uint64_t seed, Stream_job job, uint64_t job_idx, int chunk)
+{
+  return Rng_stream(seed ^ (uint64_t(job) * 0x9e3779b97f4a7c15ULL), job_idx * config_model_chunks + chunk);
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param random number stream
+ * @param number of nodes
+ * @Returns a random node index, one random number up to 2^32 nodes and two above
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex>
+inline Vertex random_node_index(Rng_stream &rng, Vertex num_nodes)
+{
+  if (uint64_t(num_nodes) <= (uint64_t(1) << 32))
+    return Vertex(rng.next() * num_nodes);
+
+  double r = rng.next();
+  r += rng.next() * (1.0 / 4294967296.0);
+  Vertex idx = Vertex(r * double(num_nodes));
+  return idx < num_nodes ? idx : num_nodes - 1;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * Pairs of nodes of one chunk of links of er_network, smaller node first
+ * Called with a chunk and a function of the pair, the same pairs every time
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex>
+struct Er_chunk_pairs {
+
+  uint64_t seed;
+  long num_links;
+  Vertex num_nodes;
+
+  template <class Function>
+  void operator()(int c, Function pair_found) const {
+    Rng_stream rng = job_stream(seed, job_links, 0, c);
+    for (long e = chunk_begin(num_links, c); e < chunk_begin(num_links, c + 1); ++e) {
+      Vertex u = random_node_index(rng, num_nodes);
+      Vertex v = random_node_index(rng, num_nodes);
+      if (u != v) pair_found(min(u, v), max(u, v));
+    }
+  }
+};
+
+
+/*-------------------------------------------------------------------------------
+ * @param number of nodes
+ * @param average degree
+ * @param seed of the random number streams
+ * @param graph snapshot to build, thresholds set to 0
+ * @param number of threads, 0 for the number of hardware threads
+ * Every chunk of links draws its pairs of nodes, pairs are grouped by the range of
+ * their smaller node, sorted and merged one range at a time
+ * Self-loops and repeated pairs are drawn again from one serial stream until the
+ * network has int(N*avg_degree/2) distinct links
+ * @return number of pairs that were drawn again
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+inline long er_network(Vertex num_nodes, double avg_degree, uint64_t seed, Flat_graph_t<Vertex, Offset> &net,
+		       int num_threads = 0)
+{
+  long num_links = long(double(num_nodes) * avg_degree / 2);
+
+  const int num_ranges = config_model_chunks;
+  auto range_of = [num_nodes](Vertex u) { return int(uint64_t(u) * num_ranges / num_nodes); };
+
+  // Pair e of chunk c, smaller node first, the same pair every time it is drawn
+  Er_chunk_pairs<Vertex> draw_chunk = {seed, num_links, num_nodes};
+
+
+  // Pairs are drawn twice, once to count the pairs of every range, then to store them
+  vector<long> range_count(long(config_model_chunks) * num_ranges, 0);
+
+  parallel_for(config_model_chunks, num_threads, [&](int c) {
+      long *chunk_count = &range_count[long(c) * num_ranges];
+      draw_chunk(c, [&](Vertex u, Vertex) { ++chunk_count[range_of(u)]; });
+    });
+
+  vector<long> range_start(num_ranges + 1, 0);
+  long pos = 0;
+  for (int r = 0; r < num_ranges; ++r) {
+    range_start[r] = pos;
+    for (int c = 0; c < config_model_chunks; ++c) {
+      long n = range_count[long(c) * num_ranges + r];
+      range_count[long(c) * num_ranges + r] = pos;
+      pos += n;
+    }
+  }
+  range_start[num_ranges] = pos;
+
+  vector<pair<Vertex, Vertex> > links(pos);
+
+  parallel_for(config_model_chunks, num_threads, [&](int c) {
+      long *chunk_pos = &range_count[long(c) * num_ranges];
+      draw_chunk(c, [&](Vertex u, Vertex v) { links[chunk_pos[range_of(u)]++] = make_pair(u, v); });
+    });
+
+
+  // Distinct pairs of every range
+  vector<long> range_end(num_ranges);
+  parallel_for(num_ranges, num_threads, [&](int r) {
+      sort(links.begin() + range_start[r], links.begin() + range_start[r+1]);
+      range_end[r] = unique(links.begin() + range_start[r], links.begin() + range_start[r+1]) - links.begin();
+    });
+
+  long num_distinct = 0;
+  for (int r = 0; r < num_ranges; ++r) num_distinct += range_end[r] - range_start[r];
+
+
+  // Missing links, few compared to the network
+  set<pair<Vertex, Vertex> > extra_links;
+  Rng_stream rng = job_stream(seed, job_extra_links, 0, 0);
+
+  while (num_distinct + long(extra_links.size()) < num_links) {
+    Vertex u = random_node_index(rng, num_nodes);
+    Vertex v = random_node_index(rng, num_nodes);
+    if (u == v) continue;
+
+    pair<Vertex, Vertex> link(min(u, v), max(u, v));
+    int r = range_of(link.first);
+    if (!binary_search(links.begin() + range_start[r], links.begin() + range_end[r], link))
+      extra_links.insert(link);
+  }
+
+
+  // Link ends of all the links
+  vector<Vertex> link_ends;
+  link_ends.reserve(2 * num_links);
+  for (int r = 0; r < num_ranges; ++r)
+    for (long e = range_start[r]; e < range_end[r]; ++e) {
+      link_ends.push_back(links[e].first);
+      link_ends.push_back(links[e].second);
+    }
+  vector<pair<Vertex, Vertex> >().swap(links);
+
+  typename set<pair<Vertex, Vertex> >::iterator it;
+  for (it = extra_links.begin(); it != extra_links.end(); ++it) {
+    link_ends.push_back(it->first);
+    link_ends.push_back(it->second);
+  }
+
+  net.build_from_links(num_nodes, num_links, link_ends.data());
+
+  return num_links - num_distinct;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * Links of er_network for the streamed build of a compressed snapshot: the pairs of
+ * every chunk in chunk order, then the links drawn again
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex>
+struct Er_links {
+
+  Er_chunk_pairs<Vertex> draw_chunk;
+  const set<pair<Vertex, Vertex> > *extra_links;
+
+  template <class Function>
+  void operator()(Function f) const {
+    for (int c = 0; c < config_model_chunks; ++c) draw_chunk(c, f);
+
+    typename set<pair<Vertex, Vertex> >::const_iterator it;
+    for (it = extra_links->begin(); it != extra_links->end(); ++it) f(it->first, it->second);
+  }
+};
+
+
+/*-------------------------------------------------------------------------------
+ * @param number of nodes
+ * @param average degree
+ * @param seed of the random number streams
+ * @param compressed snapshot to build, thresholds set to 0
+ * @param number of threads, unused and unnamed: the chunks are drawn one after another,
+ * kept so both snapshots are built with the same call
+ * @param largest number of link ends held uncompressed, see build_from_link_source
+ * Same links as the flat snapshot of er_network above, streamed from the pairs of the
+ * chunks: the snapshot of the drawn pairs gives the number of distinct links and the
+ * links already present, the missing links are drawn as above, and if there are any
+ * the snapshot is streamed again with them, the first one freed before
+ * @return number of pairs that were drawn again
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+inline long er_network(Vertex num_nodes, double avg_degree, uint64_t seed, Compressed_graph_t<Vertex, Offset> &net,
+		       int /*num_threads*/ = 0, size_t max_range_ends = compressed_range_ends)
+{
+  long num_links = long(double(num_nodes) * avg_degree / 2);
+
+  set<pair<Vertex, Vertex> > extra_links;
+  Er_links<Vertex> links = {{seed, num_links, num_nodes}, &extra_links};
+
+  net.build_from_link_source(num_nodes, links, max_range_ends);
+  long num_distinct = net.get_num_edges();
+
+
+  // Missing links, few compared to the network
+  Rng_stream rng = job_stream(seed, job_extra_links, 0, 0);
+
+  while (num_distinct + long(extra_links.size()) < num_links) {
+    Vertex u = random_node_index(rng, num_nodes);
+    Vertex v = random_node_index(rng, num_nodes);
+    if (u == v) continue;
+
+    pair<Vertex, Vertex> link(min(u, v), max(u, v));
+    if (!net.connection_check(link.first, link.second))
+      extra_links.insert(link);
+  }
+
+  if (!extra_links.empty())
+    net.build_from_link_source(num_nodes, links, max_range_ends);
+
+  return num_links - num_distinct;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @params threshold values and the probability of the first one
+ * @param seed of the random number streams
+ * @param number of threads, 0 for the number of hardware threads
+ * Same distribution as set_init_threshold_frac, one stream per chunk of nodes
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+inline void set_init_threshold_frac(Flat_graph_t<Vertex, Offset> &net, int threshold1, double prob_thresh1,
+				    int threshold2, double prob_thresh2, uint64_t seed, int num_threads)
+{
+  Vertex num_nodes = net.get_num_vertices();
+
+  parallel_for(config_model_chunks, num_threads, [&](int c) {
+      Rng_stream rng = job_stream(seed, job_thresholds, 0, c);
+      for (long i = chunk_begin(num_nodes, c); i < chunk_begin(num_nodes, c + 1); ++i)
+	net.set_threshold(Vertex(i), rng.next() < prob_thresh1 ? threshold1 : threshold2);
+    });
+}
+
+
+/*-------------------------------------------------------------------------------
+ * Choice of the nodes of one attack
+ * Every node gets a random key from the stream of its chunk of nodes, in the index of
+ * the built network, the attack removes the num_init_attack nodes with the smallest
+ * keys (the index breaks ties), a uniformly random set of nodes
+ * Keys are uniform, so the last removed key lies close to num_init_attack/N of the key
+ * range: nodes below a window of 8 standard deviations around it are removed while the
+ * keys are drawn, the keys in the window are kept and searched for the last one
+ * Usage: scan_chunk for every chunk, in any order and on any thread, then finish
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex>
+class Attack_keys {
+
+protected:
+
+  uint64_t seed;
+  uint64_t attack_idx;
+  Vertex num_nodes;
+  Vertex num_init_attack;
+
+  // Keys below low are removed, keys from low to high are kept
+  uint32_t low;
+  uint64_t high;
+
+  vector<long> num_below;
+  vector<vector<pair<uint32_t, Vertex> > > window;
+
+public:
+
+  Attack_keys(uint64_t seed_inp, uint64_t attack_idx_inp, Vertex num_nodes_inp, Vertex num_init_attack_inp);
+
+  template <class Function>
+  void scan_chunk(int chunk, Function node_removed);
+
+  template <class Function>
+  bool finish(Function node_removed);
+
+  template <class Function>
+  void choose_all(Function node_removed);
+};
+
+
+/*-------------------------------------------------------------------------------
+ * @param percolation probability
+ * @param graph snapshot
+ * @param live degree of every node, a state made by reset_live_degree or by earlier runs
+ * @param seed of the random number streams
+ * @param attack number, attacks with different numbers are independent
+ * @param number of threads, 0 for the number of hardware threads
+ * All the links are deleted from int((1-p)N) randomly chosen nodes
+ * Nodes are chosen in the index of the built network, as in initial_random_attack, the
+ * live degrees are then counted again for every node at once
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset, class Degrees>
+inline void initial_random_attack(double p, Flat_graph_t<Vertex, Offset> &net, Degrees &degree, uint64_t seed,
+				  uint64_t attack_idx, int num_threads)
+{
+  Vertex num_nodes = net.get_num_vertices();
+  Vertex num_init_attack = Vertex((1. - p) * num_nodes);
+  if (num_init_attack <= 0) return;
+
+  vector<char> removed(num_nodes, 0);
+  auto node_removed = [&](Vertex i) { removed[net.get_label(i)] = 1; };
+
+  Attack_keys<Vertex> keys(seed, attack_idx, num_nodes, num_init_attack);
+  parallel_for(config_model_chunks, num_threads, [&](int c) { keys.scan_chunk(c, node_removed); });
+
+  if (!keys.finish(node_removed)) {
+    removed.assign(num_nodes, 0);
+    keys.choose_all(node_removed);
+  }
+
+  // Live neighbors of every node, written apart so no node reads a changed degree
+  vector<int> new_degree(num_nodes, 0);
+  parallel_for(config_model_chunks, num_threads, [&](int c) {
+      typename Flat_graph_t<Vertex, Offset>::node_neighbor_iterator it;
+      for (long i = chunk_begin(num_nodes, c); i < chunk_begin(num_nodes, c + 1); ++i) {
+	if (removed[i] || degree[i] <= 0) continue;
+	int count = 0;
+	for (it = net.vertex_neighbor_begin(Vertex(i)); it != net.vertex_neighbor_end(Vertex(i)); ++it)
+	  if (degree[*it] > 0 && !removed[*it]) ++count;
+	new_degree[i] = count;
+      }
+    });
+
+  parallel_for(config_model_chunks, num_threads, [&](int c) {
+      for (long i = chunk_begin(num_nodes, c); i < chunk_begin(num_nodes, c + 1); ++i) degree[i] = new_degree[i];
+    });
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param vector with one percolation probability per realization, at most 64
+ * @param graph snapshot
+ * @param vector to store the alive mask of every node
+ * @param seed of the random number streams
+ * @param attack number of realization 0, realization l is attack first_attack+l
+ * @param number of threads, 0 for the number of hardware threads
+ * Realization l removes the same nodes as initial_random_attack with attack number
+ * first_attack+l, bits of unused realizations are left 0
+ * A chunk of nodes is scanned for all realizations by one thread, so every alive mask
+ * is written by one thread, the few nodes of the key windows are removed after
+-------------------------------------------------------------------------------*/
+
+
+inline void bitpar_random_attack(const vector<double> &p, Flat_graph &net, vector<uint64_t> &alive, uint64_t seed,
+				 uint64_t first_attack, int num_threads)
+{
+  int num_nodes = net.get_num_vertices();
+  int num_lanes = p.size();
+
+  uint64_t all_lanes = num_lanes >= 64 ? ~uint64_t(0) : (uint64_t(1) << num_lanes) - 1;
+  alive.assign(num_nodes, all_lanes);
+
+  vector<Attack_keys<int> > keys;
+  for (int lane = 0; lane < num_lanes; ++lane)
+    keys.push_back(Attack_keys<int>(seed, first_attack + lane, num_nodes, int((1. - p[lane]) * num_nodes)));
+
+  parallel_for(config_model_chunks, num_threads, [&](int c) {
+      for (int lane = 0; lane < num_lanes; ++lane) {
+	uint64_t bit = uint64_t(1) << lane;
+	keys[lane].scan_chunk(c, [&](int i) { alive[net.get_label(i)] &= ~bit; });
+      }
+    });
+
+  for (int lane = 0; lane < num_lanes; ++lane) {
+    uint64_t bit = uint64_t(1) << lane;
+    auto node_removed = [&](int i) { alive[net.get_label(i)] &= ~bit; };
+
+    if (!keys[lane].finish(node_removed)) {
+      for (int i = 0; i < num_nodes; ++i) alive[i] |= bit;
+      keys[lane].choose_all(node_removed);
+    }
+  }
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param value of every attack, in attack order
+ * @param mean
+ * @param standard deviation
+ * Sums are taken in attack order, so threads finishing in any order give the same digits
+-------------------------------------------------------------------------------*/
+
+
+inline void ensemble_mean_sd(const vector<double> &value, double &mean, double &sd)
+{
+  double sum = 0.0, sum_sq = 0.0;
+  for (size_t a = 0; a < value.size(); ++a) {
+    sum += value[a];
+    sum_sq += value[a] * value[a];
+  }
+
+  double num_attacks = value.size();
+  mean = sum / num_attacks;
+  double var = sum_sq / num_attacks - mean * mean;
+  sd = sqrt(var > 0 ? var : 0.0);
+}
+
+
+//------------------------------Member function definitions----------------------
+
+
+/*-------------------------------------------------------------------------------
+ * @param seed of the random number streams
+ * @param attack number
+ * @param number of nodes
+ * @param number of nodes to remove, nothing is removed if not positive
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex>
+inline Attack_keys<Vertex>::Attack_keys(uint64_t seed_inp, uint64_t attack_idx_inp, Vertex num_nodes_inp,
+					Vertex num_init_attack_inp)
+  : seed(seed_inp), attack_idx(attack_idx_inp), num_nodes(num_nodes_inp), num_init_attack(num_init_attack_inp),
+    low(0), high(0), num_below(config_model_chunks, 0), window(config_model_chunks)
+{
+  if (num_init_attack <= 0) return;
+
+  double margin = 8.0 * sqrt(double(num_init_attack)) + 64.0;
+  double key_low = (double(num_init_attack) - margin) / double(num_nodes) * 4294967296.0;
+  double key_high = (double(num_init_attack) + margin) / double(num_nodes) * 4294967296.0;
+
+  low = key_low > 0.0 ? uint32_t(key_low) : 0;
+  high = key_high < 4294967296.0 ? uint64_t(key_high) : (uint64_t(1) << 32);
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param chunk of nodes
+ * @param function called with the index of every removed node of the chunk
+ * Removes the nodes of the chunk with keys below the window, keeps the window keys
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex>
+template <class Function>
+inline void Attack_keys<Vertex>::scan_chunk(int chunk, Function node_removed)
+{
+  if (num_init_attack <= 0) return;
+
+  Rng_stream rng = job_stream(seed, job_attack, attack_idx, chunk);
+  long count = 0;
+
+  for (long i = chunk_begin(num_nodes, chunk); i < chunk_begin(num_nodes, chunk + 1); ++i) {
+    uint32_t key = rng.next_bits();
+    if (key < low) {
+      node_removed(Vertex(i));
+      ++count;
+    }
+    else if (key < high) window[chunk].push_back(make_pair(key, Vertex(i)));
+  }
+
+  num_below[chunk] = count;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param function called with the index of every removed node of the window
+ * Removes the nodes of the window up to the last removed key, once all chunks are scanned
+ * @Returns false if the last removed key is not in the window, nothing is removed then
+ * and the attack is made again with choose_all
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex>
+template <class Function>
+inline bool Attack_keys<Vertex>::finish(Function node_removed)
+{
+  if (num_init_attack <= 0) return true;
+
+  long below = 0;
+  vector<pair<uint32_t, Vertex> > keys;
+  for (int c = 0; c < config_model_chunks; ++c) {
+    below += num_below[c];
+    keys.insert(keys.end(), window[c].begin(), window[c].end());
+  }
+
+  long num_window = num_init_attack - below;
+  if (num_window < 0 || num_window > long(keys.size())) return false;
+
+  if (num_window > 0) {
+    nth_element(keys.begin(), keys.begin() + (num_window - 1), keys.end());
+    for (long j = 0; j < num_window; ++j) node_removed(keys[j].second);
+  }
+
+  return true;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param function called with the index of every removed node
+ * Removes the nodes of the attack from all the keys, one thread
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex>
+template <class Function>
+inline void Attack_keys<Vertex>::choose_all(Function node_removed)
+{
+  vector<pair<uint32_t, Vertex> > keys(num_nodes);
+
+  for (int c = 0; c < config_model_chunks; ++c) {
+    Rng_stream rng = job_stream(seed, job_attack, attack_idx, c);
+    for (long i = chunk_begin(num_nodes, c); i < chunk_begin(num_nodes, c + 1); ++i)
+      keys[i] = make_pair(rng.next_bits(), Vertex(i));
+  }
+
+  nth_element(keys.begin(), keys.begin() + (num_init_attack - 1), keys.end());
+  for (Vertex j = 0; j < num_init_attack; ++j) node_removed(keys[j].second);
+}
+
+
+#endif
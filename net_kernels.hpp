@@ -0,0 +1,296 @@
+/*-------------------------------------------------------------------------------
+ * Attack and prune kernels specialized for common threshold configurations
+ * 1. Threshold_alphabet finds the distinct local kcore thresholds of a network
+ * 2. Threshold access for a uniform threshold (no per node storage) and for two
+ *    thresholds (one bit per node), with compile time values for common runs
+ * 3. Candidate search and prune scans instantiated for every threshold access
+ * 4. network_prune and attack_and_prune choose the kernel for the network at runtime
+ * All kernels remove the same nodes and count prune scans as net_ops_flat.hpp does
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+
+#ifndef NET_KERNELS_HPP
+#define NET_KERNELS_HPP
+
+
+/*-----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "flat_graph.hpp"
+
+#include "net_ops_flat.hpp"
+
+/*-----------------------------------------------------------------------------*/
+
+
+/*-------------------------------------------------------------------------------
+ * Threshold access: same threshold for every node
+-------------------------------------------------------------------------------*/
+
+
+template <int K>
+struct Threshold_uniform {
+  int operator()(size_t) const { return K; }
+};
+
+
+struct Threshold_uniform_runtime {
+
+  int k;
+
+  Threshold_uniform_runtime(int k_inp) : k(k_inp) {}
+
+  int operator()(size_t) const { return k; }
+};
+
+
+/*-------------------------------------------------------------------------------
+ * Threshold access: two thresholds, bit of the node set for the higher one
+-------------------------------------------------------------------------------*/
+
+
+template <int LOW, int HIGH>
+struct Threshold_two_valued {
+
+  const uint64_t *select;
+
+  Threshold_two_valued(const uint64_t *select_inp) : select(select_inp) {}
+
+  int operator()(size_t node_idx) const {
+    return (select[node_idx / 64] >> (node_idx % 64)) & 1 ? HIGH : LOW; }
+};
+
+
+struct Threshold_two_valued_runtime {
+
+  const uint64_t *select;
+  int low, high;
+
+  Threshold_two_valued_runtime(const uint64_t *select_inp, int low_inp, int high_inp)
+    : select(select_inp), low(low_inp), high(high_inp) {}
+
+  int operator()(size_t node_idx) const {
+    return (select[node_idx / 64] >> (node_idx % 64)) & 1 ? high : low; }
+};
+
+
+/*-------------------------------------------------------------------------------
+ * Describes the local thresholds of a network for the choice of kernel
+ * Keeps the bit per node for two thresholds
+-------------------------------------------------------------------------------*/
+
+
+class Threshold_alphabet {
+
+protected:
+
+  // Number of distinct threshold values, 3 stands for 3 or more
+  int num_values;
+
+
+  // Smallest and largest threshold value
+  int low, high;
+
+
+  // Bit of a node is set if its threshold is the larger one of two
+  vector<uint64_t> select;
+
+
+public:
+
+  template <class Vertex, class Offset> void build_from(Flat_graph_t<Vertex, Offset> &net);
+
+  int get_num_values() { return num_values; }
+  int get_low() { return low; }
+  int get_high() { return high; }
+  const uint64_t * select_data() { return select.data(); }
+
+  // No node has a threshold above 1, pruning never removes a node
+  bool prunes_no_node() { return num_values <= 2 && high <= 1; }
+
+  Threshold_alphabet() : num_values(0), low(0), high(0) {}
+  template <class Vertex, class Offset>
+  Threshold_alphabet(Flat_graph_t<Vertex, Offset> &net) { build_from(net); }
+};
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * Finds the distinct thresholds of the network
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset>
+inline void Threshold_alphabet::build_from(Flat_graph_t<Vertex, Offset> &net)
+{
+  Vertex num_nodes = net.get_num_vertices();
+
+  num_values = 0;
+  low = high = 0;
+
+  for (Vertex i = 0; i < num_nodes; ++i) {
+    int t = net.get_threshold(i);
+    if (num_values == 0) { low = high = t; num_values = 1; }
+    else if (t != low && t != high) {
+      if (num_values == 1) { num_values = 2; if (t < low) low = t; else high = t; }
+      else { num_values = 3; break; }
+    }
+  }
+
+  select.assign((num_nodes + 63) / 64, 0);
+  if (num_values == 2)
+    for (Vertex i = 0; i < num_nodes; ++i)
+      if (net.get_threshold(i) == high)
+	select[i / 64] |= uint64_t(1) << (i % 64);
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param live degree of every node
+ * @param threshold access
+ * @param vector to store the bitmask of prunable nodes
+ * Candidate search for the first prune scan of every threshold access
+ * A uniform threshold is compared without reading a threshold array, two thresholds
+ * combine the searches for the lower and the higher value with the bit of every node
+-------------------------------------------------------------------------------*/
+
+
+template <class Degrees>
+inline void find_candidates(Degrees &degree, const Threshold_array &threshold, vector<uint64_t> &mask)
+{
+  find_prune_candidates(degree.data(), threshold.threshold, degree.size(), mask);
+}
+
+
+template <class Degrees, int K>
+inline void find_candidates(Degrees &degree, const Threshold_uniform<K> &, vector<uint64_t> &mask)
+{
+  find_prune_candidates_uniform(degree.data(), K, degree.size(), mask);
+}
+
+
+template <class Degrees>
+inline void find_candidates(Degrees &degree, const Threshold_uniform_runtime &threshold, vector<uint64_t> &mask)
+{
+  find_prune_candidates_uniform(degree.data(), threshold.k, degree.size(), mask);
+}
+
+
+template <class Degrees>
+inline void combine_two_valued_candidates(Degrees &degree, const uint64_t *select, int low, int high,
+					  vector<uint64_t> &mask)
+{
+  vector<uint64_t> mask_high;
+  find_prune_candidates_uniform(degree.data(), low, degree.size(), mask);
+  find_prune_candidates_uniform(degree.data(), high, degree.size(), mask_high);
+
+  // Nodes below the lower threshold are below both, select decides for the rest
+  for (size_t w = 0; w < mask.size(); ++w)
+    mask[w] = (mask[w] & ~select[w]) | (mask_high[w] & select[w]);
+}
+
+
+template <class Degrees, int LOW, int HIGH>
+inline void find_candidates(Degrees &degree, const Threshold_two_valued<LOW,HIGH> &threshold, vector<uint64_t> &mask)
+{
+  combine_two_valued_candidates(degree, threshold.select, LOW, HIGH, mask);
+}
+
+
+template <class Degrees>
+inline void find_candidates(Degrees &degree, const Threshold_two_valued_runtime &threshold, vector<uint64_t> &mask)
+{
+  combine_two_valued_candidates(degree, threshold.select, threshold.low, threshold.high, mask);
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param live degree of every node
+ * @param threshold access
+ * Candidate search and prune scans with one threshold access
+ * @return count of the number of prune scans of the entire network
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset, class Threshold, class Degrees>
+inline int network_prune_kernel(Flat_graph_t<Vertex, Offset> &net, Degrees &degree, const Threshold &threshold)
+{
+  vector<uint64_t> candidates;
+  find_candidates(degree, threshold, candidates);
+
+  return prune_scans(net, degree, threshold, candidates);
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param live degree of every node
+ * @param thresholds of the network
+ * Same result as network_prune
+ * Uniform thresholds up to 1 need no pruning, uniform 2 to 5 and the pairs {1,2} and {2,3}
+ * use compile time thresholds, other uniform and two threshold networks keep one value
+ * or one bit per node, anything else reads the threshold array
+ * @return count of the number of prune scans of the entire network
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset, class Degrees>
+inline int network_prune(Flat_graph_t<Vertex, Offset> &net, Degrees &degree, Threshold_alphabet &alphabet)
+{
+  int low = alphabet.get_low(), high = alphabet.get_high();
+
+  if (alphabet.get_num_values() == 1) {
+
+    // No node can be pruned, one scan finds nothing
+    if (low <= 1) return 1;
+
+    switch (low) {
+    case 2: return network_prune_kernel(net, degree, Threshold_uniform<2>());
+    case 3: return network_prune_kernel(net, degree, Threshold_uniform<3>());
+    case 4: return network_prune_kernel(net, degree, Threshold_uniform<4>());
+    case 5: return network_prune_kernel(net, degree, Threshold_uniform<5>());
+    default: return network_prune_kernel(net, degree, Threshold_uniform_runtime(low));
+    }
+  }
+
+  if (alphabet.get_num_values() == 2) {
+
+    const uint64_t *select = alphabet.select_data();
+
+    if (low == 1 && high == 2)
+      return network_prune_kernel(net, degree, Threshold_two_valued<1,2>(select));
+    if (low == 2 && high == 3)
+      return network_prune_kernel(net, degree, Threshold_two_valued<2,3>(select));
+
+    return network_prune_kernel(net, degree, Threshold_two_valued_runtime(select, low, high));
+  }
+
+  return network_prune_kernel(net, degree, Threshold_array(net.threshold_data()));
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param percolation probability
+ * @param graph snapshot
+ * @param live degree of every node, reset to the snapshot before the call
+ * @param thresholds of the network
+ * Same result as initial_random_attack followed by network_prune
+ * @return count of the number of prune scans of the entire network
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex, class Offset, class Degrees>
+inline int attack_and_prune(double p, Flat_graph_t<Vertex, Offset> &net, Degrees &degree, Threshold_alphabet &alphabet)
+{
+  initial_random_attack(p, net, degree);
+
+  return network_prune(net, degree, alphabet);
+}
+
+
+#endif
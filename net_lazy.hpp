@@ -0,0 +1,268 @@
+/*-------------------------------------------------------------------------------
+ * Early exit and lazy evaluation of the sweeps over percolation probabilities
+ * 1. Live state of a run: number of live nodes and sum of their live degrees
+ * 2. Biggest cluster size of a step, computed only as far as needed
+ * 3. Record of the work done and skipped by a sweep, printed at the end of a run
+ * Every shortcut gives the size find_biggest_cluster in net_ops_flat.hpp gives:
+ *   a state without live nodes has a biggest cluster of one node, no search is needed
+ *   the search stops once the biggest cluster is at least the live nodes not yet visited
+ *   in a nested sweep (nodes and links are only removed from one step to the next) a
+ *   live degree sum that did not change means no live link was removed, the clusters of
+ *   the step before are kept, and once no node is live every later step is empty
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+
+#ifndef NET_LAZY_HPP
+#define NET_LAZY_HPP
+
+
+/*-----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <iostream>
+
+/*-----------------------------------------------------------------------------*/
+
+
+/*-------------------------------------------------------------------------------
+ * Number of live nodes and sum of their live degrees, twice the number of live links
+-------------------------------------------------------------------------------*/
+
+
+struct Live_state {
+
+  long num_live;
+  long degree_sum;
+
+  Live_state(long num_live_inp = 0, long degree_sum_inp = 0) : num_live(num_live_inp), degree_sum(degree_sum_inp) {}
+
+  bool operator==(const Live_state &other) const {
+    return num_live == other.num_live && degree_sum == other.degree_sum; }
+};
+
+
+/*-------------------------------------------------------------------------------
+ * @param live degree of every node
+ * @param number of nodes
+ * @Returns live state of the run
+-------------------------------------------------------------------------------*/
+
+
+template <class Degrees>
+inline Live_state live_state(Degrees &degree, long num_nodes)
+{
+  const int *deg = degree.data();
+  long num_live = 0, degree_sum = 0;
+
+  for (long i = 0; i < num_nodes; ++i) {
+    num_live += deg[i] > 0;
+    degree_sum += deg[i];
+  }
+
+  return Live_state(num_live, degree_sum);
+}
+
+
+/*-------------------------------------------------------------------------------
+ * Biggest cluster sizes of the steps of one sweep, with the work done and skipped
+-------------------------------------------------------------------------------*/
+
+
+class Lazy_sweep {
+
+protected:
+
+  // Steps of the sweep are nested, clusters of an unchanged step are kept
+  bool nested;
+
+
+  // State and biggest cluster size of the step before
+  Live_state last_state;
+  long last_biggest;
+  bool has_last;
+
+
+  // Steps without live nodes, in all and in a row up to the last step
+  long num_empty;
+  int num_empty_in_row;
+
+
+  // Steps with an unchanged network, steps searched and steps not simulated at all
+  long num_kept;
+  long num_searched;
+  long num_not_simulated;
+
+
+  // Live nodes of the searched steps, and those visited before the search stopped
+  long num_live_searched;
+  long num_live_visited;
+
+public:
+
+  Lazy_sweep(bool nested_inp)
+    : nested(nested_inp), last_biggest(0), has_last(false), num_empty(0), num_empty_in_row(0),
+      num_kept(0), num_searched(0), num_not_simulated(0), num_live_searched(0), num_live_visited(0) {}
+
+
+  // Biggest cluster size of the state of the step, counted as find_biggest_cluster does
+  template <class Graph, class Degrees>
+  long biggest_cluster_size(Graph &net, Degrees &degree);
+
+
+  // Size of a step found without a search, for sweeps with their own search (net_bond.hpp)
+  template <class Degrees>
+  bool size_known(Degrees &degree, long num_nodes, long &size);
+
+
+  // Size found by the search of a step whose size was not known
+  void searched(long size, long num_visited);
+
+
+  // Nested sweep without live nodes: every later step is empty
+  bool collapsed() { return nested && has_last && last_state.num_live == 0; }
+  int get_num_empty_in_row() { return num_empty_in_row; }
+  long get_num_live() { return last_state.num_live; }
+
+
+  // Steps written without being simulated
+  void skip_steps(long num_steps) { num_not_simulated += num_steps; }
+
+
+  // Prints the work done and skipped
+  void report(ostream &out);
+};
+
+
+//------------------------------Member function definitions----------------------
+
+
+/*-------------------------------------------------------------------------------
+ * @param live degree of every node
+ * @param number of nodes
+ * @param size of the biggest cluster, set if it is known
+ * Records the live state of the step
+ * @Returns true if no node is live or the network of a nested sweep is unchanged
+-------------------------------------------------------------------------------*/
+
+
+template <class Degrees>
+inline bool Lazy_sweep::size_known(Degrees &degree, long num_nodes, long &size)
+{
+  Live_state state = live_state(degree, num_nodes);
+
+  bool kept = nested && has_last && state == last_state;
+  has_last = true;
+  last_state = state;
+
+  if (state.num_live == 0) {
+    ++num_empty;
+    ++num_empty_in_row;
+    size = last_biggest = (num_nodes > 0 ? 1 : 0);
+    return true;
+  }
+  num_empty_in_row = 0;
+
+  if (kept) {
+    ++num_kept;
+    size = last_biggest;
+    return true;
+  }
+
+  return false;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param size of the biggest cluster
+ * @param number of live nodes visited by the search
+-------------------------------------------------------------------------------*/
+
+
+inline void Lazy_sweep::searched(long size, long num_visited)
+{
+  ++num_searched;
+  num_live_searched += last_state.num_live;
+  num_live_visited += num_visited;
+  last_biggest = size;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot, Flat_graph_t or Compressed_graph_t
+ * @param live degree of every node
+ * Clusters are searched from the live nodes only, a node list is not kept
+ * @Returns size of the biggest cluster, 1 if no node is live
+-------------------------------------------------------------------------------*/
+
+
+template <class Graph, class Degrees>
+inline long Lazy_sweep::biggest_cluster_size(Graph &net, Degrees &degree)
+{
+  typedef typename Graph::vertex_type Vertex;
+
+  Vertex num_nodes = net.get_num_vertices();
+
+  long biggest = 1;
+  if (size_known(degree, num_nodes, biggest)) return biggest;
+
+  long num_live = last_state.num_live, num_visited = 0;
+
+  vector<char> marked(num_nodes, 0);
+  vector<Vertex> search_stack;
+  typename Graph::node_neighbor_iterator it;
+
+  for (Vertex idx_node = 0; idx_node < num_nodes && biggest < num_live - num_visited; ++idx_node) {
+
+    if (marked[idx_node] || degree[idx_node] <= 0) continue;
+
+    long cluster_size = 1;
+    marked[idx_node] = 1;
+    search_stack.push_back(idx_node);
+
+    while (!search_stack.empty()) {
+
+      Vertex idx_search = search_stack.back();
+      search_stack.pop_back();
+
+      for (it = net.vertex_neighbor_begin(idx_search); it != net.vertex_neighbor_end(idx_search); ++it)
+	if (degree[*it] > 0 && !marked[*it]) {
+	  marked[*it] = 1;
+	  search_stack.push_back(*it);
+	  ++cluster_size;
+	}
+    }
+
+    num_visited += cluster_size;
+    if (cluster_size > biggest) biggest = cluster_size;
+  }
+
+  searched(biggest, num_visited);
+
+  return biggest;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param output stream
+-------------------------------------------------------------------------------*/
+
+
+inline void Lazy_sweep::report(ostream &out)
+{
+  long num_steps = num_empty + num_kept + num_searched + num_not_simulated;
+
+  out << "\n steps: " << num_steps << ", not simulated after the collapse: " << num_not_simulated
+      << ", without live nodes: " << num_empty << ", network unchanged: " << num_kept
+      << ", clusters searched: " << num_searched << endl;
+
+  if (num_live_visited < num_live_searched)
+    out << " live nodes not visited by the stopped searches: "
+	<< 100.0 * (num_live_searched - num_live_visited) / num_live_searched << "%" << endl;
+}
+
+
+#endif
@@ -29,7 +29,8 @@
 -------------------------------------------------------------------------------*/
 
 
-inline void find_biggest_cluster(Graph & net, vector<int> & biggest_cluster) {
+template <class Alloc>
+inline void find_biggest_cluster(Graph_t<Alloc> & net, vector<int> & biggest_cluster) {
 
   biggest_cluster.clear();
   int num_nodes = net.get_num_vertices();
@@ -43,7 +44,7 @@ inline void find_biggest_cluster(Graph & net, vector<int> & biggest_cluster) {
   stack<int> search_stack;
   int idx_search;
 
-  Graph::node_neighbor_iterator idx_neighbor;
+  typename Graph_t<Alloc>::node_neighbor_iterator idx_neighbor;
 
   // temp cluster keeps all the interconnected nodes in a vector
   vector<int> temp_cluster;
@@ -95,7 +96,8 @@ inline void find_biggest_cluster(Graph & net, vector<int> & biggest_cluster) {
 -------------------------------------------------------------------------------*/
 
 
-inline void initial_random_attack(double p, Graph &net){
+template <class Alloc>
+inline void initial_random_attack(double p, Graph_t<Alloc> &net){
   
   // p is the probability that a node survives random attack
   int num_nodes=net.get_num_vertices();
@@ -134,7 +136,8 @@ inline void initial_random_attack(double p, Graph &net){
 -------------------------------------------------------------------------------*/
 
 
-int network_prune(Graph &net) { 
+template <class Alloc>
+int network_prune(Graph_t<Alloc> &net) { 
 
   
   int num_nodes;
@@ -0,0 +1,468 @@
+/*-------------------------------------------------------------------------------
+ * Percolation process functions on a Flat_graph snapshot
+ * The state of a run is the live degree of every node, a removed node has degree 0
+ * A link of the snapshot is present as long as both its end nodes have degree > 0
+ * 1. Function to find the biggest cluster in the network
+ * 2. Function to remove randomly chosen nodes with percolation probability
+ * 3. Prune network to satisfy kcore condition
+ * Every function consumes random numbers and counts prune scans exactly as the
+ * list based functions in net_ops.hpp do, so both give identical output
+ * Functions are templated on the snapshot, a Flat_graph_t of any index types (see
+ * flat_graph.hpp) or a Compressed_graph_t (net_compressed.hpp) read through the same
+ * neighbor iterators, and on the live degree array, a vector or a Degree_buffer owned
+ * by the caller
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+
+#ifndef NET_OPS_FLAT_HPP
+#define NET_OPS_FLAT_HPP
+
+
+/*-----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include <stack>
+
+#include <vector>
+
+#include "flat_graph.hpp"
+
+#include "net_simd.hpp"
+
+/*-----------------------------------------------------------------------------*/
+
+
+/*-------------------------------------------------------------------------------
+ * Live degree array in memory owned by the caller, used in place of a vector
+ * so runs can work on the buffers of a program using the library (kcore_api.h)
+-------------------------------------------------------------------------------*/
+
+
+struct Degree_buffer {
+
+  int *first;
+  size_t num;
+
+  Degree_buffer(int *first_inp, size_t num_inp) : first(first_inp), num(num_inp) {}
+
+  int * data() { return first; }
+  size_t size() const { return num; }
+  int & operator[](size_t i) { return first[i]; }
+};
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param vector to store the live degree of every node
+ * Resets the run state to the snapshot, all links present
+-------------------------------------------------------------------------------*/
+
+
+template <class Graph>
+inline void reset_live_degree(Graph &net, vector<int> &degree)
+{
+  degree = net.initial_degrees();
+}
+
+
+template <class Graph>
+inline void reset_live_degree(Graph &net, Degree_buffer &degree)
+{
+  copy(net.initial_degrees().begin(), net.initial_degrees().end(), degree.data());
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param live degree of every node
+ * @param integer index of the node to be removed
+ * Removes all the links of the node and updates the degree of its neighbors
+-------------------------------------------------------------------------------*/
+
+
+template <class Graph, class Degrees>
+inline void rm_a_node(Graph &net, Degrees &degree, typename Graph::vertex_type node_idx)
+{
+  typename Graph::node_neighbor_iterator it;
+  for (it = net.vertex_neighbor_begin(node_idx); it != net.vertex_neighbor_end(node_idx); ++it)
+    if (degree[*it] > 0)
+      --degree[*it];
+
+  degree[node_idx] = 0;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param live degree of every node
+ * @param input vector to store indices of nodes in biggest connected cluster
+ * Finds the biggest connected cluster using only links between live nodes
+-------------------------------------------------------------------------------*/
+
+
+template <class Graph, class Degrees>
+inline void find_biggest_cluster(Graph &net, Degrees &degree, vector<typename Graph::vertex_type> &biggest_cluster)
+{
+  typedef typename Graph::vertex_type Vertex;
+
+  biggest_cluster.clear();
+  Vertex num_nodes = net.get_num_vertices();
+
+  // Keep track of nodes visited
+  vector<char> marked(num_nodes, 0);
+
+  stack<Vertex> search_stack;
+  Vertex idx_search;
+
+  typename Graph::node_neighbor_iterator idx_neighbor;
+
+  // temp cluster keeps all the interconnected nodes in a vector
+  vector<Vertex> temp_cluster;
+
+
+  for (Vertex idx_node = 0; idx_node < num_nodes; ++idx_node) {
+
+    if (marked[idx_node]) continue;
+
+    temp_cluster.clear();
+    temp_cluster.push_back(idx_node);
+    marked[idx_node] = 1;
+
+    // A node with no live links is a cluster of its own
+    if (degree[idx_node] > 0)
+      search_stack.push(idx_node);
+
+    while (!search_stack.empty()) {
+
+      idx_search = search_stack.top();
+      search_stack.pop();
+
+      for (idx_neighbor = net.vertex_neighbor_begin(idx_search);
+	   idx_neighbor != net.vertex_neighbor_end(idx_search); ++idx_neighbor)
+	if (degree[*idx_neighbor] > 0 && !marked[*idx_neighbor]) {
+	  search_stack.push(*idx_neighbor);
+	  temp_cluster.push_back(*idx_neighbor);
+	  marked[*idx_neighbor] = 1;
+	}
+    }
+
+    if (temp_cluster.size() > biggest_cluster.size())
+      biggest_cluster = temp_cluster;
+  }
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param live degree of every node
+ * @param array of num_nodes entries owned by the caller, NULL for the size only
+ * Finds the same cluster as find_biggest_cluster above without keeping node lists:
+ * sizes are counted first, then the biggest cluster is searched again from its first
+ * node and its nodes are written to the array in the order of the vector version
+ * @Returns size of the biggest cluster
+-------------------------------------------------------------------------------*/
+
+
+template <class Graph, class Degrees>
+inline size_t find_biggest_cluster(Graph &net, Degrees &degree, typename Graph::vertex_type *biggest_cluster)
+{
+  typedef typename Graph::vertex_type Vertex;
+
+  Vertex num_nodes = net.get_num_vertices();
+  if (num_nodes == 0) return 0;
+
+  // 1 once visited by the counting search, 2 once written to the array
+  vector<char> marked(num_nodes, 0);
+
+  stack<Vertex> search_stack;
+  typename Graph::node_neighbor_iterator idx_neighbor;
+
+  size_t biggest_size = 0;
+  Vertex biggest_start = 0;
+
+  for (Vertex idx_node = 0; idx_node < num_nodes; ++idx_node) {
+
+    if (marked[idx_node]) continue;
+
+    size_t cluster_size = 1;
+    marked[idx_node] = 1;
+
+    if (degree[idx_node] > 0)
+      search_stack.push(idx_node);
+
+    while (!search_stack.empty()) {
+
+      Vertex idx_search = search_stack.top();
+      search_stack.pop();
+
+      for (idx_neighbor = net.vertex_neighbor_begin(idx_search);
+	   idx_neighbor != net.vertex_neighbor_end(idx_search); ++idx_neighbor)
+	if (degree[*idx_neighbor] > 0 && !marked[*idx_neighbor]) {
+	  search_stack.push(*idx_neighbor);
+	  marked[*idx_neighbor] = 1;
+	  ++cluster_size;
+	}
+    }
+
+    if (cluster_size > biggest_size) {
+      biggest_size = cluster_size;
+      biggest_start = idx_node;
+    }
+  }
+
+  if (!biggest_cluster) return biggest_size;
+
+
+  // Search the biggest cluster again, writing its nodes as they are found
+  size_t num_written = 0;
+  biggest_cluster[num_written++] = biggest_start;
+  marked[biggest_start] = 2;
+
+  if (degree[biggest_start] > 0)
+    search_stack.push(biggest_start);
+
+  while (!search_stack.empty()) {
+
+    Vertex idx_search = search_stack.top();
+    search_stack.pop();
+
+    for (idx_neighbor = net.vertex_neighbor_begin(idx_search);
+	 idx_neighbor != net.vertex_neighbor_end(idx_search); ++idx_neighbor)
+      if (degree[*idx_neighbor] > 0 && marked[*idx_neighbor] != 2) {
+	search_stack.push(*idx_neighbor);
+	biggest_cluster[num_written++] = *idx_neighbor;
+	marked[*idx_neighbor] = 2;
+      }
+  }
+
+  return biggest_size;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param number of nodes
+ * @Returns a random node index, one random number up to 2^32 nodes and two above
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex>
+inline Vertex random_node_index(Vertex num_nodes)
+{
+  if (uint64_t(num_nodes) <= (uint64_t(1) << 32))
+    return Vertex(srand() * num_nodes);
+
+  double r = srand();
+  r += srand() * (1.0 / 4294967296.0);
+  Vertex idx = Vertex(r * double(num_nodes));
+  return idx < num_nodes ? idx : num_nodes - 1;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param percolation probability
+ * @param graph snapshot
+ * @param live degree of every node
+ * All the links are deleted from randomly chosen nodes
+ * Draws random numbers in the same sequence as initial_random_attack in net_ops.hpp
+ * and removes the same nodes of the built network if the snapshot is relabeled
+-------------------------------------------------------------------------------*/
+
+
+template <class Graph, class Degrees>
+inline void initial_random_attack(double p, Graph &net, Degrees &degree)
+{
+  typedef typename Graph::vertex_type Vertex;
+
+  Vertex num_nodes = net.get_num_vertices();
+
+  // Keep track of nodes already chosen
+  vector<char> removed(num_nodes, 0);
+  Vertex num_removed = 0;
+
+  Vertex num_init_attack = Vertex((1. - p) * num_nodes);
+
+  while (num_removed < num_init_attack) {
+
+    // Random choice is made in the index of the built network
+    Vertex node_idx = net.get_label(random_node_index(num_nodes));
+
+    if (degree[node_idx])
+      rm_a_node(net, degree, node_idx);
+
+    if (!removed[node_idx]) {
+      removed[node_idx] = 1;
+      ++num_removed;
+    }
+  }
+}
+
+
+/*-------------------------------------------------------------------------------
+ * Threshold access used by the prune kernel
+ * Threshold_array reads the threshold array of the snapshot, the specialized
+ * versions in net_kernels.hpp replace it with a constant or with one bit per node
+-------------------------------------------------------------------------------*/
+
+
+struct Threshold_array {
+
+  const int *threshold;
+
+  Threshold_array(const int *threshold_inp) : threshold(threshold_inp) {}
+
+  int operator()(size_t node_idx) const { return threshold[node_idx]; }
+};
+
+
+/*-------------------------------------------------------------------------------
+ * Order of nodes in a prune scan, the index of the built network
+ * rank is the position of a node in the scan, node the snapshot index at a position
+-------------------------------------------------------------------------------*/
+
+
+template <class Vertex>
+struct Scan_order_identity {
+  Vertex node(Vertex rank) const { return rank; }
+  Vertex rank(Vertex node_idx) const { return node_idx; }
+};
+
+
+template <class Vertex>
+struct Scan_order_relabeled {
+
+  const Vertex *label;
+  const Vertex *original;
+
+  Scan_order_relabeled(const Vertex *label_inp, const Vertex *original_inp) : label(label_inp), original(original_inp) {}
+
+  Vertex node(Vertex rank) const { return label[rank]; }
+  Vertex rank(Vertex node_idx) const { return original[node_idx]; }
+};
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param live degree of every node
+ * @param threshold access, called with the node index
+ * @param bitmask of scan positions to be visited in the first scan, used up
+ * @param order of nodes in a scan
+ * The scans of network_prune in net_ops.hpp are replayed with bitmasks of candidates:
+ * a node that becomes a candidate while a node earlier in the scan is removed is visited
+ * in the same scan, otherwise in the next
+ * Only candidates are visited, but the same nodes are removed in the same scans
+ * @return count of the number of prune scans of the entire network
+-------------------------------------------------------------------------------*/
+
+
+template <class Graph, class Threshold, class Order, class Degrees>
+inline int prune_scans(Graph &net, Degrees &degree, const Threshold &threshold,
+		       vector<uint64_t> &current, const Order &order)
+{
+  typedef typename Graph::vertex_type Vertex;
+
+  // Candidates of the next scan
+  vector<uint64_t> next(current.size(), 0);
+
+  int num_prune_iterations = 0;
+  bool removed_any;
+
+  typename Graph::node_neighbor_iterator it;
+
+  do {
+
+    ++num_prune_iterations;
+    removed_any = false;
+
+    for (size_t w = 0; w < current.size(); ++w) {
+
+      // current[w] is read again after every removal as later nodes of this word may be added
+      while (current[w]) {
+
+	Vertex rank = Vertex(w * 64 + __builtin_ctzll(current[w]));
+	current[w] &= current[w] - 1;
+
+	Vertex node_idx = order.node(rank);
+	if (!(degree[node_idx] > 0 && degree[node_idx] < threshold(node_idx)))
+	  continue;
+
+	for (it = net.vertex_neighbor_begin(node_idx); it != net.vertex_neighbor_end(node_idx); ++it) {
+	  Vertex nb = *it;
+	  if (degree[nb] > 0) {
+	    --degree[nb];
+	    if (degree[nb] > 0 && degree[nb] < threshold(nb)) {
+	      Vertex nb_rank = order.rank(nb);
+	      if (nb_rank > rank) current[nb_rank / 64] |= uint64_t(1) << (nb_rank % 64);
+	      else next[nb_rank / 64] |= uint64_t(1) << (nb_rank % 64);
+	    }
+	  }
+	}
+
+	degree[node_idx] = 0;
+	removed_any = true;
+      }
+    }
+
+    current.swap(next);
+
+    // Stop when no nodes are removed in a scan
+  } while (removed_any);
+
+  return num_prune_iterations;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param live degree of every node
+ * @param threshold access
+ * @param bitmask of candidates for the first scan in snapshot index, used up
+ * Runs the prune scans in the index order of the built network, so a relabeled
+ * snapshot counts the same scans as the snapshot it was made from
+ * @return count of the number of prune scans of the entire network
+-------------------------------------------------------------------------------*/
+
+
+template <class Graph, class Threshold, class Degrees>
+inline int prune_scans(Graph &net, Degrees &degree, const Threshold &threshold,
+		       vector<uint64_t> &candidates)
+{
+  typedef typename Graph::vertex_type Vertex;
+
+  if (!net.is_relabeled())
+    return prune_scans(net, degree, threshold, candidates, Scan_order_identity<Vertex>());
+
+  Scan_order_relabeled<Vertex> order(net.label_data(), net.original_index_data());
+  vector<uint64_t> ranked(candidates.size(), 0);
+
+  for (size_t w = 0; w < candidates.size(); ++w)
+    for (uint64_t word = candidates[w]; word; word &= word - 1) {
+      Vertex rank = order.rank(Vertex(w * 64 + __builtin_ctzll(word)));
+      ranked[rank / 64] |= uint64_t(1) << (rank % 64);
+    }
+
+  return prune_scans(net, degree, threshold, ranked, order);
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param live degree of every node
+ * Pruning = Remove links from all nodes whose degree is less than its local kcore threshold
+ * Scan 1 starts from the vectorized candidate search over the whole network
+ * @return count of the number of prune scans of the entire network
+-------------------------------------------------------------------------------*/
+
+
+template <class Graph, class Degrees>
+inline int network_prune(Graph &net, Degrees &degree)
+{
+  vector<uint64_t> candidates;
+  find_prune_candidates(degree.data(), net.threshold_data(), net.get_num_vertices(), candidates);
+
+  return prune_scans(net, degree, Threshold_array(net.threshold_data()), candidates);
+}
+
+
+#endif
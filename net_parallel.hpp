@@ -0,0 +1,296 @@
+/*-------------------------------------------------------------------------------
+ * Frontier based pruning of a Flat_graph snapshot
+ * Every generation of the pruning cascade removes all prunable nodes at once,
+ * the nodes that become prunable by these removals form the next generation
+ * 1. Serial frontier engine
+ * 2. Multi-threaded frontier engine, threads share the frontier of a generation and
+ *    decrement the live degree of neighbors with atomic operations
+ * Both engines leave the same kcore as network_prune in net_ops_flat.hpp and count the
+ * same generations, which differ from the prune scans counted by network_prune
+ * 3. parallel_for, runs independent work items on a group of threads
+ * Threads of both are pinned to cpus when set_thread_pinning is on (net_placement.hpp)
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+
+#ifndef NET_PARALLEL_HPP
+#define NET_PARALLEL_HPP
+
+
+/*-----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <atomic>
+
+#include <thread>
+
+#include "flat_graph.hpp"
+
+#include "net_ops_flat.hpp"
+
+#include "net_placement.hpp"
+
+/*-----------------------------------------------------------------------------*/
+
+
+/*-------------------------------------------------------------------------------
+ * Barrier for a fixed group of threads, reused by every generation
+ * Threads spin for a short while and then yield, so more threads than cores still progress
+-------------------------------------------------------------------------------*/
+
+
+class Spin_barrier {
+
+protected:
+
+  int num_threads;
+  atomic<int> num_waiting;
+  atomic<int> phase;
+
+public:
+
+  void wait() {
+    int my_phase = phase.load(memory_order_relaxed);
+
+    if (num_waiting.fetch_add(1, memory_order_acq_rel) == num_threads - 1) {
+      num_waiting.store(0, memory_order_relaxed);
+      phase.store(my_phase + 1, memory_order_release);
+      return;
+    }
+
+    for (int spin = 0; phase.load(memory_order_acquire) == my_phase; ++spin)
+      if (spin > 1000) this_thread::yield();
+  }
+
+  Spin_barrier(int num_threads_inp) : num_threads(num_threads_inp), num_waiting(0), phase(0) {}
+};
+
+
+/*-------------------------------------------------------------------------------
+ * @param number of work items
+ * @param number of threads, 0 for the number of hardware threads
+ * @param function called with the index of every work item
+ * Threads take the next item from a shared counter, so results must not depend on
+ * which thread runs an item, no thread is started without items
+-------------------------------------------------------------------------------*/
+
+
+template <class Function>
+inline void parallel_for(int num_items, int num_threads, Function work)
+{
+  if (num_items <= 0) return;
+
+  if (num_threads <= 0) num_threads = thread::hardware_concurrency();
+  if (num_threads <= 0) num_threads = 1;
+  if (num_threads > num_items) num_threads = num_items;
+
+  atomic<int> next_item(0);
+
+  auto worker = [&](int t) {
+    Pinned_thread pin(t, num_threads);
+    for (int item = next_item++; item < num_items; item = next_item++) work(item);
+  };
+
+  vector<thread> threads;
+  for (int t = 1; t < num_threads; ++t) threads.push_back(thread(worker, t));
+  worker(0);
+  for (size_t t = 0; t < threads.size(); ++t) threads[t].join();
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param live degree of every node
+ * @param threshold access, called with the node index
+ * @param nodes of the first generation, all prunable
+ * Removes whole generations: every node of the frontier still linked to the network
+ * is removed, a neighbor whose degree falls from its threshold to a positive value
+ * joins the next frontier
+ * @return count of the number of generations, the last one removing no node
+-------------------------------------------------------------------------------*/
+
+
+template <class Threshold>
+inline int prune_generations(Flat_graph &net, vector<int> &degree, const Threshold &threshold, vector<int> &frontier)
+{
+  vector<int> next;
+  int num_generations = 0;
+
+  Flat_graph::node_neighbor_iterator it;
+
+  while (true) {
+
+    ++num_generations;
+
+    // A node of the frontier may have lost all its links in the last generation
+    size_t num_kept = 0;
+    for (size_t f = 0; f < frontier.size(); ++f)
+      if (degree[frontier[f]] > 0) {
+	degree[frontier[f]] = 0;
+	frontier[num_kept++] = frontier[f];
+      }
+    frontier.resize(num_kept);
+
+    if (frontier.empty()) break;
+
+    next.clear();
+    for (size_t f = 0; f < frontier.size(); ++f)
+      for (it = net.vertex_neighbor_begin(frontier[f]); it != net.vertex_neighbor_end(frontier[f]); ++it) {
+	int nb = *it;
+	if (degree[nb] > 0 && degree[nb]-- == threshold(nb) && degree[nb] > 0)
+	  next.push_back(nb);
+      }
+
+    frontier.swap(next);
+  }
+
+  return num_generations;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param live degree of every node
+ * Serial frontier engine, first generation from the vectorized candidate search
+ * @return count of the number of generations of the pruning cascade
+-------------------------------------------------------------------------------*/
+
+
+inline int network_prune_frontier(Flat_graph &net, vector<int> &degree)
+{
+  vector<uint64_t> mask;
+  vector<int> frontier;
+
+  find_prune_candidates(degree.data(), net.threshold_data(), net.get_num_vertices(), mask);
+  prune_candidate_list(mask, frontier);
+
+  return prune_generations(net, degree, Threshold_array(net.threshold_data()), frontier);
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param live degree of every node
+ * @param threshold access, called with the node index
+ * @param nodes of the first generation, all prunable
+ * @param number of threads
+ * Same generations as prune_generations, every thread takes one slice of the frontier
+ * 1. Nodes of the slice still linked to the network get degree 0
+ * 2. Neighbors are decremented atomically, the thread whose decrement takes a neighbor
+ *    from its threshold to a positive value puts it in its part of the next frontier
+ * 3. The parts are joined into the next frontier
+ * The steps are separated by barriers, so a node removed in step 1 is seen as removed
+ * by all threads in step 2, and a neighbor with degree > 0 in step 2 still has a live
+ * link to the node being removed, so its degree never falls below zero
+ * The order of the next frontier depends on thread timing, its set of nodes does not
+ * @return count of the number of generations, the last one removing no node
+-------------------------------------------------------------------------------*/
+
+
+template <class Threshold>
+inline int prune_generations_parallel(Flat_graph &net, vector<int> &degree, const Threshold &threshold,
+				      vector<int> &frontier, int num_threads)
+{
+  vector<vector<int> > kept(num_threads), next(num_threads);
+  vector<long> num_kept(num_threads, 0);
+
+  Spin_barrier barrier(num_threads);
+  int num_generations = 0;
+  bool done = false;
+
+  int *deg = degree.data();
+
+  auto worker = [&](int t) {
+
+    Pinned_thread pin(t, num_threads);
+    Flat_graph::node_neighbor_iterator it;
+
+    while (true) {
+
+      // 1. Remove the nodes of this slice
+      size_t first = frontier.size() * t / num_threads;
+      size_t last = frontier.size() * (t + 1) / num_threads;
+
+      kept[t].clear();
+      for (size_t f = first; f < last; ++f)
+	if (deg[frontier[f]] > 0) {
+	  deg[frontier[f]] = 0;
+	  kept[t].push_back(frontier[f]);
+	}
+      num_kept[t] = kept[t].size();
+
+      barrier.wait();
+
+      // 2. Decrement neighbors
+      next[t].clear();
+      for (size_t f = 0; f < kept[t].size(); ++f)
+	for (it = net.vertex_neighbor_begin(kept[t][f]); it != net.vertex_neighbor_end(kept[t][f]); ++it) {
+	  int nb = *it;
+	  if (__atomic_load_n(deg + nb, __ATOMIC_RELAXED) > 0) {
+	    int old_degree = __atomic_fetch_sub(deg + nb, 1, __ATOMIC_RELAXED);
+	    if (old_degree == threshold(nb) && old_degree > 1)
+	      next[t].push_back(nb);
+	  }
+	}
+
+      barrier.wait();
+
+      // 3. Join the next frontier
+      if (t == 0) {
+	long total_kept = 0;
+	for (int s = 0; s < num_threads; ++s) total_kept += num_kept[s];
+
+	++num_generations;
+	if (total_kept == 0) done = true;
+
+	frontier.clear();
+	for (int s = 0; s < num_threads; ++s)
+	  frontier.insert(frontier.end(), next[s].begin(), next[s].end());
+      }
+
+      barrier.wait();
+
+      if (done) return;
+    }
+  };
+
+  vector<thread> threads;
+  for (int t = 1; t < num_threads; ++t) threads.push_back(thread(worker, t));
+  worker(0);
+  for (size_t t = 0; t < threads.size(); ++t) threads[t].join();
+
+  return num_generations;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param live degree of every node
+ * @param number of threads, 0 for the number of hardware threads
+ * Multi-threaded frontier engine, same kcore and generations as network_prune_frontier
+ * @return count of the number of generations of the pruning cascade
+-------------------------------------------------------------------------------*/
+
+
+inline int network_prune_parallel(Flat_graph &net, vector<int> &degree, int num_threads = 0)
+{
+  if (num_threads <= 0) num_threads = thread::hardware_concurrency();
+  if (num_threads <= 0) num_threads = 1;
+
+  vector<uint64_t> mask;
+  vector<int> frontier;
+
+  find_prune_candidates(degree.data(), net.threshold_data(), net.get_num_vertices(), mask);
+  prune_candidate_list(mask, frontier);
+
+  if (num_threads == 1)
+    return prune_generations(net, degree, Threshold_array(net.threshold_data()), frontier);
+
+  return prune_generations_parallel(net, degree, Threshold_array(net.threshold_data()), frontier, num_threads);
+}
+
+
+#endif
@@ -0,0 +1,375 @@
+/*-------------------------------------------------------------------------------
+ * Placement of the arrays of a network in memory, for machines with several NUMA nodes
+ * 1. Huge pages: an array is backed by transparent huge pages (madvise), pages that are
+ *    already filled are collapsed at once where the kernel supports it (linux 6.1)
+ * 2. NUMA nodes: an array is interleaved page by page over all nodes, or split in one
+ *    slice per thread and every slice moved to the node of the cpu of its thread
+ * 3. Thread pinning: threads of net_parallel.hpp are pinned to cpus ordered by node,
+ *    thread t of a group on the node that holds slice t
+ * Arrays are placed after they are filled, so vectors of a snapshot keep their type and
+ * pages are moved by the kernel (mbind), no NUMA library is needed
+ * Placement is a hint: calls the kernel does not support leave the array where it is,
+ * results of a run never depend on placement or pinning
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+
+#ifndef NET_PLACEMENT_HPP
+#define NET_PLACEMENT_HPP
+
+
+/*-----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include <stdio.h>
+
+#include <string.h>
+
+#include <vector>
+
+#include <algorithm>
+
+#include <string>
+
+#include <fstream>
+
+#include <sstream>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Linux 6.1, missing from older headers, older kernels reject it with EINVAL
+#ifndef MADV_COLLAPSE
+#define MADV_COLLAPSE 25
+#endif
+#endif
+
+/*-----------------------------------------------------------------------------*/
+
+
+enum Page_policy { pages_default, pages_huge };
+
+enum Node_policy { nodes_default, nodes_interleave, nodes_partition };
+
+
+/*-------------------------------------------------------------------------------
+ * Placement of an array: page size, NUMA nodes, and threads of the partition
+-------------------------------------------------------------------------------*/
+
+
+struct Memory_placement {
+
+  Page_policy pages;
+  Node_policy nodes;
+
+  // Number of slices of nodes_partition, 0 for the number of cpus
+  int num_threads;
+
+  Memory_placement(Page_policy pages_inp = pages_default, Node_policy nodes_inp = nodes_default,
+		   int num_threads_inp = 0)
+    : pages(pages_inp), nodes(nodes_inp), num_threads(num_threads_inp) {}
+};
+
+
+/*-------------------------------------------------------------------------------
+ * Cpus of the machine ordered by NUMA node, read once from /sys
+ * A machine without node information is one node with all cpus
+-------------------------------------------------------------------------------*/
+
+
+class Numa_topology {
+
+protected:
+
+  vector<int> cpus;
+  vector<int> cpu_node;
+  int num_nodes;
+
+public:
+
+  Numa_topology();
+
+  int get_num_nodes() { return num_nodes; }
+  int get_num_cpus() { return cpus.size(); }
+
+
+  // Cpu of thread t of a group, threads spread evenly over the cpus in node order
+  int cpu_of_thread(int t, int num_threads);
+  int node_of_thread(int t, int num_threads) { return cpu_node[cpu_of_thread(t, num_threads)]; }
+};
+
+
+inline Numa_topology & numa_topology()
+{
+  static Numa_topology topology;
+  return topology;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * Pinning of worker threads, off unless set, read by Pinned_thread
+-------------------------------------------------------------------------------*/
+
+
+inline bool & thread_pinning()
+{
+  static bool pinning = false;
+  return pinning;
+}
+
+
+inline void set_thread_pinning(bool pinning)
+{
+  thread_pinning() = pinning;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * Pins the calling thread as thread t of a group while in scope, if pinning is set
+ * The cpus the thread was allowed before are restored at the end of the scope
+-------------------------------------------------------------------------------*/
+
+
+class Pinned_thread {
+
+protected:
+
+  bool pinned;
+#ifdef __linux__
+  cpu_set_t old_mask;
+#endif
+
+public:
+
+  Pinned_thread(int t, int num_threads) : pinned(false) {
+#ifdef __linux__
+    if (!thread_pinning()) return;
+
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    CPU_SET(numa_topology().cpu_of_thread(t, num_threads), &mask);
+
+    pinned = sched_getaffinity(0, sizeof(old_mask), &old_mask) == 0
+      && sched_setaffinity(0, sizeof(mask), &mask) == 0;
+#endif
+  }
+
+  ~Pinned_thread() {
+#ifdef __linux__
+    if (pinned) sched_setaffinity(0, sizeof(old_mask), &old_mask);
+#endif
+  }
+};
+
+
+/*-------------------------------------------------------------------------------
+ * @param first and last byte of the array, whole pages
+ * @param placement
+ * Moves the pages to the NUMA nodes of the placement
+ * @Returns true if every kernel call succeeded
+-------------------------------------------------------------------------------*/
+
+
+inline bool place_pages_on_nodes(uintptr_t first, uintptr_t last, const Memory_placement &placement)
+{
+#ifdef __linux__
+  Numa_topology &topology = numa_topology();
+  if (placement.nodes == nodes_default || topology.get_num_nodes() < 2 || first >= last) return true;
+
+  const int mpol_preferred = 1, mpol_interleave = 3;
+  const unsigned long mpol_mf_move = 2;
+  const uintptr_t page = sysconf(_SC_PAGESIZE);
+
+  vector<unsigned long> node_mask(topology.get_num_nodes() / 64 + 1, 0);
+  unsigned long max_node = node_mask.size() * 64;
+
+  if (placement.nodes == nodes_interleave) {
+    for (int n = 0; n < topology.get_num_nodes(); ++n) node_mask[n / 64] |= 1ul << (n % 64);
+    return syscall(SYS_mbind, first, last - first, mpol_interleave, node_mask.data(), max_node, mpol_mf_move) == 0;
+  }
+
+  int num_threads = placement.num_threads > 0 ? placement.num_threads : topology.get_num_cpus();
+  uintptr_t num_pages = (last - first) / page;
+  bool success = true;
+
+  for (int t = 0; t < num_threads; ++t) {
+    uintptr_t slice_first = first + num_pages * t / num_threads * page;
+    uintptr_t slice_last = first + num_pages * (t + 1) / num_threads * page;
+    if (slice_first == slice_last) continue;
+
+    int n = topology.node_of_thread(t, num_threads);
+    node_mask.assign(node_mask.size(), 0);
+    node_mask[n / 64] |= 1ul << (n % 64);
+
+    if (syscall(SYS_mbind, slice_first, slice_last - slice_first, mpol_preferred, node_mask.data(), max_node,
+		mpol_mf_move) != 0)
+      success = false;
+  }
+
+  return success;
+#else
+  return false;
+#endif
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param first byte of the array
+ * @param number of bytes
+ * @param placement
+ * Only the whole pages inside the array are placed, huge pages only the 2 MB aligned
+ * part, the pages at both ends are shared with other data
+ * Pages are moved to their nodes first, so they are collapsed on the node they stay on
+ * @Returns true if every kernel call succeeded
+-------------------------------------------------------------------------------*/
+
+
+inline bool place_array(void *data, size_t bytes, const Memory_placement &placement)
+{
+#ifdef __linux__
+  const uintptr_t huge_page = uintptr_t(1) << 21;
+  const uintptr_t page = sysconf(_SC_PAGESIZE);
+
+  uintptr_t first = uintptr_t(data), last = first + bytes;
+
+  bool success = place_pages_on_nodes((first + page - 1) & ~(page - 1), last & ~(page - 1), placement);
+
+  uintptr_t huge_first = (first + huge_page - 1) & ~(huge_page - 1);
+  uintptr_t huge_last = last & ~(huge_page - 1);
+
+  if (placement.pages == pages_huge && huge_first < huge_last) {
+    if (madvise((void *) huge_first, huge_last - huge_first, MADV_HUGEPAGE) != 0) success = false;
+
+    // Pages already filled become huge pages now instead of in the background
+    // Its failure is ignored on purpose: MADV_HUGEPAGE above decides success, older
+    // kernels do not know MADV_COLLAPSE and khugepaged collapses the pages later
+    madvise((void *) huge_first, huge_last - huge_first, MADV_COLLAPSE);
+  }
+
+  return success;
+#else
+  return false;
+#endif
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param array filled to its final size, per-node state such as the live degree
+ * @param placement
+ * The placement stays with the memory of the vector, also when it is assigned
+ * from a vector of the same size
+-------------------------------------------------------------------------------*/
+
+
+template <class T>
+inline bool place_vector(vector<T> &array, const Memory_placement &placement)
+{
+  return place_array(array.data(), array.size() * sizeof(T), placement);
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot, Flat_graph_t or Compressed_graph_t
+ * @param placement
+ * Places every array of the snapshot
+-------------------------------------------------------------------------------*/
+
+
+template <class Graph>
+inline bool place_graph(Graph &net, const Memory_placement &placement)
+{
+  bool success = true;
+  net.visit_arrays([&](void *data, size_t bytes) {
+      if (bytes && !place_array(data, bytes, placement)) success = false; });
+
+  return success;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @Returns bytes of this process in transparent huge pages, -1 if not known
+-------------------------------------------------------------------------------*/
+
+
+inline long huge_page_bytes()
+{
+  ifstream smaps("/proc/self/smaps_rollup");
+  string line;
+
+  while (getline(smaps, line))
+    if (line.compare(0, 14, "AnonHugePages:") == 0) {
+      long kilobytes = -1;
+      istringstream(line.substr(14)) >> kilobytes;
+      return kilobytes < 0 ? -1 : kilobytes * 1024;
+    }
+
+  return -1;
+}
+
+
+//------------------------------Member function definitions----------------------
+
+
+/*-------------------------------------------------------------------------------
+ * Reads the cpus of every node from /sys/devices/system/node/node<n>/cpulist,
+ * lists like 0-3,8-11
+-------------------------------------------------------------------------------*/
+
+
+inline Numa_topology::Numa_topology() : num_nodes(0)
+{
+  for (int n = 0; ; ++n) {
+
+    ostringstream ostr_file;
+    ostr_file << "/sys/devices/system/node/node" << n << "/cpulist";
+    ifstream cpulist(ostr_file.str().c_str());
+    if (!cpulist) break;
+
+    string range;
+    while (getline(cpulist, range, ',')) {
+      int low = -1, high = -1;
+      if (sscanf(range.c_str(), "%d-%d", &low, &high) < 2) high = low;
+      for (int c = low; c >= 0 && c <= high; ++c) {
+	cpus.push_back(c);
+	if (int(cpu_node.size()) <= c) cpu_node.resize(c + 1, 0);
+	cpu_node[c] = n;
+      }
+    }
+
+    ++num_nodes;
+  }
+
+  if (cpus.empty()) {
+    num_nodes = 1;
+#ifdef __linux__
+    long num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+#else
+    long num_cpus = 1;
+#endif
+    for (int c = 0; c < max(num_cpus, 1l); ++c) cpus.push_back(c);
+    cpu_node.assign(cpus.size(), 0);
+  }
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param thread index in the group
+ * @param number of threads of the group
+ * @Returns cpu of the thread, groups larger than the machine wrap around
+-------------------------------------------------------------------------------*/
+
+
+inline int Numa_topology::cpu_of_thread(int t, int num_threads)
+{
+  int num_cpus = cpus.size();
+  if (num_threads <= num_cpus) return cpus[long(t) * num_cpus / num_threads];
+
+  return cpus[t % num_cpus];
+}
+
+
+#endif
@@ -0,0 +1,234 @@
+/*-------------------------------------------------------------------------------
+ * Hysteresis of kcore percolation on a Flat_graph snapshot
+ * Nodes are present in one random order, at percolation probability p the first
+ * num_present_nodes(p, N) nodes of the order are present (net_sweep.hpp)
+ * Removal branch: from p = 1 downwards the last present nodes are removed and the
+ *   network is pruned from the state of the step before, giving the kcore of the
+ *   present nodes as a fresh run would
+ * Recovery branch: from the lowest p upwards the nodes are added back in order, a
+ *   present node becomes active once it has at least threshold active neighbors (a node
+ *   with threshold up to 1 at once), activations spread to the neighbors and active
+ *   nodes stay active, clusters of active nodes are joined with union-find
+ * Active nodes satisfy the kcore condition, so the recovery branch lies on or below the
+ * removal branch, below it where the collapse of the kcore is not undone (hysteresis)
+ * Every node is activated once and every link joined once over the whole recovery
+ * 1. Removal step with incremental pruning
+ * 2. Recovery state built from the removal branch, nodes added back
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+
+#ifndef NET_RECOVERY_HPP
+#define NET_RECOVERY_HPP
+
+
+/*-----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "flat_graph.hpp"
+
+#include "net_ops_flat.hpp"
+
+#include "net_cores.hpp"
+
+/*-----------------------------------------------------------------------------*/
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param order in which nodes are present
+ * @param number of present nodes, set to the new number
+ * @param new number of present nodes, not above the present one
+ * @param live degree of every node, pruned state of the present nodes
+ * Removes the last present nodes and prunes, starting from their neighbors
+ * @return count of the number of prune scans
+-------------------------------------------------------------------------------*/
+
+
+inline int removal_step(Flat_graph &net, const vector<int> &order, int &num_present, int num_present_new,
+			vector<int> &degree)
+{
+  int num_nodes = net.get_num_vertices();
+  const int *threshold = net.threshold_data();
+
+  vector<uint64_t> candidates((num_nodes + 63) / 64, 0);
+  Flat_graph::node_neighbor_iterator it;
+
+  for (; num_present > num_present_new; --num_present) {
+
+    int v = order[num_present - 1];
+    if (!degree[v]) continue;
+
+    rm_a_node(net, degree, v);
+
+    for (it = net.vertex_neighbor_begin(v); it != net.vertex_neighbor_end(v); ++it)
+      if (degree[*it] > 0 && degree[*it] < threshold[*it])
+	candidates[*it / 64] |= uint64_t(1) << (*it % 64);
+  }
+
+  return prune_scans(net, degree, Threshold_array(threshold), candidates);
+}
+
+
+/*-------------------------------------------------------------------------------
+ * State of the recovery branch: present and active nodes, active neighbors of every
+ * node and union-find clusters of the active nodes
+-------------------------------------------------------------------------------*/
+
+
+class Kcore_recovery {
+
+protected:
+
+  vector<char> present, active;
+  vector<int> num_active_neighbors;
+
+  vector<int> parent, cluster_size;
+  long biggest;
+  long num_active;
+
+  int num_present;
+
+  // Activated nodes whose neighbors are still to be updated
+  vector<int> activation_stack;
+
+  void join(int v, int u);
+  void activate(Flat_graph &net, int v);
+
+public:
+
+  Kcore_recovery(Flat_graph &net, const vector<int> &order, int num_present_inp, vector<int> &degree);
+
+  void add_nodes(Flat_graph &net, const vector<int> &order, int num_present_new);
+
+  long get_biggest_size() { return biggest; }
+  long get_num_active() { return num_active; }
+  int get_num_present() { return num_present; }
+  bool is_present(int v) { return present[v]; }
+  bool is_active(int v) { return active[v]; }
+};
+
+
+//------------------------------Member function definitions----------------------
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param order in which nodes are present
+ * @param number of present nodes
+ * @param live degree of every node, pruned state of the removal branch
+ * Nodes with live links are active, as are present nodes with threshold up to 1
+-------------------------------------------------------------------------------*/
+
+
+inline Kcore_recovery::Kcore_recovery(Flat_graph &net, const vector<int> &order, int num_present_inp,
+				      vector<int> &degree)
+  : biggest(1), num_active(0), num_present(num_present_inp)
+{
+  int num_nodes = net.get_num_vertices();
+
+  present.assign(num_nodes, 0);
+  active.assign(num_nodes, 0);
+  num_active_neighbors.assign(num_nodes, 0);
+  cluster_size.assign(num_nodes, 1);
+  parent.resize(num_nodes);
+  for (int i = 0; i < num_nodes; ++i) parent[i] = i;
+
+  for (int n = 0; n < num_present; ++n) {
+    int v = order[n];
+    present[v] = 1;
+    if (degree[v] > 0 || net.get_threshold(v) <= 1) {
+      active[v] = 1;
+      ++num_active;
+    }
+  }
+
+  Flat_graph::node_neighbor_iterator it;
+  for (int v = 0; v < num_nodes; ++v) {
+    if (!active[v]) continue;
+    for (it = net.vertex_neighbor_begin(v); it != net.vertex_neighbor_end(v); ++it) {
+      ++num_active_neighbors[*it];
+      if (active[*it] && *it < v) join(v, *it);
+    }
+  }
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param two active nodes joined by a link
+ * Union by size of their clusters
+-------------------------------------------------------------------------------*/
+
+
+inline void Kcore_recovery::join(int v, int u)
+{
+  int root_v = find_root(parent, v), root_u = find_root(parent, u);
+  if (root_v == root_u) return;
+
+  if (cluster_size[root_v] < cluster_size[root_u]) swap(root_v, root_u);
+  parent[root_u] = root_v;
+  cluster_size[root_v] += cluster_size[root_u];
+  if (cluster_size[root_v] > biggest) biggest = cluster_size[root_v];
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param present node that can be activated
+ * Activates the node and every present node it brings to its threshold, depth first
+-------------------------------------------------------------------------------*/
+
+
+inline void Kcore_recovery::activate(Flat_graph &net, int v)
+{
+  activation_stack.assign(1, v);
+  active[v] = 1;
+  ++num_active;
+
+  Flat_graph::node_neighbor_iterator it;
+
+  while (!activation_stack.empty()) {
+
+    int x = activation_stack.back();
+    activation_stack.pop_back();
+
+    for (it = net.vertex_neighbor_begin(x); it != net.vertex_neighbor_end(x); ++it) {
+      int nb = *it;
+      ++num_active_neighbors[nb];
+
+      if (active[nb]) join(x, nb);
+      else if (present[nb] && num_active_neighbors[nb] >= net.get_threshold(nb)) {
+	active[nb] = 1;
+	++num_active;
+	activation_stack.push_back(nb);
+      }
+    }
+  }
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param order in which nodes are present
+ * @param new number of present nodes, not below the present one
+ * Adds the next nodes of the order, a node is activated if enough neighbors are active
+-------------------------------------------------------------------------------*/
+
+
+inline void Kcore_recovery::add_nodes(Flat_graph &net, const vector<int> &order, int num_present_new)
+{
+  for (; num_present < num_present_new; ++num_present) {
+
+    int v = order[num_present];
+    present[v] = 1;
+
+    if (net.get_threshold(v) <= 1 || num_active_neighbors[v] >= net.get_threshold(v))
+      activate(net, v);
+  }
+}
+
+
+#endif
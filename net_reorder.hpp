@@ -0,0 +1,197 @@
+/*-------------------------------------------------------------------------------
+ * Node orderings that place linked nodes close together in memory
+ * 1. Breadth first order from the highest degree node of every cluster
+ * 2. Reverse Cuthill-McKee order
+ * 3. Order of decreasing degree
+ * Every function gives the new index of every node, applied with Flat_graph::relabel
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+
+#ifndef NET_REORDER_HPP
+#define NET_REORDER_HPP
+
+
+/*-----------------------------------------------------------------------------*/
+
+#include <vector>
+
+#include <algorithm>
+
+#include "flat_graph.hpp"
+
+/*-----------------------------------------------------------------------------*/
+
+
+// Orderings understood by reorder_nodes
+enum Node_order { order_none, order_bfs, order_rcm, order_degree };
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param vector to store node indices sorted by degree
+ * @param true for decreasing degree, false for increasing degree
+ * Counting sort, nodes of equal degree stay in index order
+-------------------------------------------------------------------------------*/
+
+
+inline void sort_by_degree(Flat_graph &net, vector<int> &sorted_nodes, bool decreasing)
+{
+  int num_nodes = net.get_num_vertices();
+
+  int max_degree = 0;
+  for (int i = 0; i < num_nodes; ++i)
+    if (net.get_deg_vertex(i) > max_degree) max_degree = net.get_deg_vertex(i);
+
+  vector<int> first_of_degree(max_degree + 2, 0);
+  for (int i = 0; i < num_nodes; ++i) {
+    int key = decreasing ? max_degree - net.get_deg_vertex(i) : net.get_deg_vertex(i);
+    ++first_of_degree[key + 1];
+  }
+  for (int d = 1; d <= max_degree + 1; ++d) first_of_degree[d] += first_of_degree[d-1];
+
+  sorted_nodes.resize(num_nodes);
+  for (int i = 0; i < num_nodes; ++i) {
+    int key = decreasing ? max_degree - net.get_deg_vertex(i) : net.get_deg_vertex(i);
+    sorted_nodes[first_of_degree[key]++] = i;
+  }
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param nodes in the order in which clusters are started
+ * @param true to visit the neighbors of a node in order of increasing degree
+ * @param vector to store the visit order of all nodes
+ * Breadth first search over every cluster
+-------------------------------------------------------------------------------*/
+
+
+inline void breadth_first_visit(Flat_graph &net, const vector<int> &start_nodes, bool neighbors_by_degree,
+				vector<int> &visit_order)
+{
+  int num_nodes = net.get_num_vertices();
+
+  vector<char> marked(num_nodes, 0);
+  vector<int> neighbors;
+
+  visit_order.clear();
+  visit_order.reserve(num_nodes);
+
+  Flat_graph::node_neighbor_iterator it;
+
+  for (size_t s = 0; s < start_nodes.size(); ++s) {
+
+    if (marked[start_nodes[s]]) continue;
+
+    size_t head = visit_order.size();
+    visit_order.push_back(start_nodes[s]);
+    marked[start_nodes[s]] = 1;
+
+    for (; head < visit_order.size(); ++head) {
+
+      int idx_search = visit_order[head];
+
+      neighbors.clear();
+      for (it = net.vertex_neighbor_begin(idx_search); it != net.vertex_neighbor_end(idx_search); ++it)
+	if (!marked[*it]) {
+	  marked[*it] = 1;
+	  neighbors.push_back(*it);
+	}
+
+      if (neighbors_by_degree)
+	stable_sort(neighbors.begin(), neighbors.end(),
+		    [&net](int a, int b) { return net.get_deg_vertex(a) < net.get_deg_vertex(b); });
+
+      visit_order.insert(visit_order.end(), neighbors.begin(), neighbors.end());
+    }
+  }
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param visit order of all nodes
+ * @param vector to store the new index of every node
+-------------------------------------------------------------------------------*/
+
+
+inline void labels_from_order(const vector<int> &visit_order, vector<int> &new_label)
+{
+  new_label.resize(visit_order.size());
+  for (size_t pos = 0; pos < visit_order.size(); ++pos)
+    new_label[visit_order[pos]] = pos;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param vector to store the new index of every node
+ * Breadth first order, clusters started from their highest degree node
+-------------------------------------------------------------------------------*/
+
+
+inline void bfs_order(Flat_graph &net, vector<int> &new_label)
+{
+  vector<int> start_nodes, visit_order;
+  sort_by_degree(net, start_nodes, true);
+  breadth_first_visit(net, start_nodes, false, visit_order);
+  labels_from_order(visit_order, new_label);
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param vector to store the new index of every node
+ * Reverse Cuthill-McKee order: breadth first from a lowest degree node of every
+ * cluster, neighbors visited in order of increasing degree, whole order reversed
+-------------------------------------------------------------------------------*/
+
+
+inline void rcm_order(Flat_graph &net, vector<int> &new_label)
+{
+  vector<int> start_nodes, visit_order;
+  sort_by_degree(net, start_nodes, false);
+  breadth_first_visit(net, start_nodes, true, visit_order);
+  reverse(visit_order.begin(), visit_order.end());
+  labels_from_order(visit_order, new_label);
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param vector to store the new index of every node
+ * Decreasing degree, the most visited nodes share cache lines
+-------------------------------------------------------------------------------*/
+
+
+inline void degree_order(Flat_graph &net, vector<int> &new_label)
+{
+  vector<int> sorted_nodes;
+  sort_by_degree(net, sorted_nodes, true);
+  labels_from_order(sorted_nodes, new_label);
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param ordering to apply
+ * Relabels the snapshot, the labels of the built network are kept in the snapshot
+-------------------------------------------------------------------------------*/
+
+
+inline void reorder_nodes(Flat_graph &net, Node_order order)
+{
+  vector<int> new_label;
+
+  switch (order) {
+  case order_bfs: bfs_order(net, new_label); break;
+  case order_rcm: rcm_order(net, new_label); break;
+  case order_degree: degree_order(net, new_label); break;
+  default: return;
+  }
+
+  net.relabel(new_label);
+}
+
+
+#endif
@@ -0,0 +1,329 @@
+/*-------------------------------------------------------------------------------
+ * Vectorized kernels over the contiguous degree and threshold arrays
+ * 1. Marks every node with 0 < degree < local kcore threshold in a bitmask
+ * 2. Counts such nodes to verify that a pruned network satisfies the kcore condition
+ * 3. Same search for a threshold shared by all nodes, without a threshold array
+ * AVX-512 and AVX2 versions are chosen at runtime, scalar version otherwise
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+
+#ifndef NET_SIMD_HPP
+#define NET_SIMD_HPP
+
+
+/*-----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include <vector>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define NET_SIMD_X86 1
+#endif
+
+/*-----------------------------------------------------------------------------*/
+
+
+// Kernel signature: bit i of mask[i/64] is set if node i is prunable
+typedef void (*prune_candidate_kernel)(const int *degree, const int *threshold, long num_nodes, uint64_t *mask);
+typedef void (*prune_candidate_uniform_kernel)(const int *degree, int threshold, long num_nodes, uint64_t *mask);
+
+
+/*-------------------------------------------------------------------------------
+ * @param arrays of live degree and local threshold of every node
+ * @param number of nodes
+ * @param bitmask with (num_nodes+63)/64 words, overwritten
+ * Scalar version, also used for the tail of the vectorized versions
+-------------------------------------------------------------------------------*/
+
+
+inline void prune_candidates_scalar(const int *degree, const int *threshold, long num_nodes, uint64_t *mask)
+{
+  long num_words = (num_nodes + 63) / 64;
+
+  for (long w = 0; w < num_words; ++w) {
+
+    uint64_t word = 0;
+    long first = w * 64;
+    long last = first + 64 < num_nodes ? first + 64 : num_nodes;
+
+    for (long i = first; i < last; ++i)
+      if (degree[i] > 0 && degree[i] < threshold[i])
+	word |= uint64_t(1) << (i - first);
+
+    mask[w] = word;
+  }
+}
+
+
+/*-------------------------------------------------------------------------------
+ * Scalar version for a threshold shared by all nodes
+-------------------------------------------------------------------------------*/
+
+
+inline void prune_candidates_uniform_scalar(const int *degree, int threshold, long num_nodes, uint64_t *mask)
+{
+  long num_words = (num_nodes + 63) / 64;
+
+  for (long w = 0; w < num_words; ++w) {
+
+    uint64_t word = 0;
+    long first = w * 64;
+    long last = first + 64 < num_nodes ? first + 64 : num_nodes;
+
+    for (long i = first; i < last; ++i)
+      if (degree[i] > 0 && degree[i] < threshold)
+	word |= uint64_t(1) << (i - first);
+
+    mask[w] = word;
+  }
+}
+
+
+#ifdef NET_SIMD_X86
+
+/*-------------------------------------------------------------------------------
+ * AVX2 version: compares 8 nodes per instruction
+-------------------------------------------------------------------------------*/
+
+
+__attribute__((target("avx2")))
+inline void prune_candidates_avx2(const int *degree, const int *threshold, long num_nodes, uint64_t *mask)
+{
+  long num_full_words = num_nodes / 64;
+  __m256i zero = _mm256_setzero_si256();
+
+  for (long w = 0; w < num_full_words; ++w) {
+
+    uint64_t word = 0;
+
+    for (int j = 0; j < 8; ++j) {
+      long i = w * 64 + j * 8;
+      __m256i deg = _mm256_loadu_si256((const __m256i *)(degree + i));
+      __m256i thr = _mm256_loadu_si256((const __m256i *)(threshold + i));
+
+      // degree > 0 and threshold > degree
+      __m256i hit = _mm256_and_si256(_mm256_cmpgt_epi32(deg, zero), _mm256_cmpgt_epi32(thr, deg));
+      word |= uint64_t(_mm256_movemask_ps(_mm256_castsi256_ps(hit))) << (j * 8);
+    }
+
+    mask[w] = word;
+  }
+
+  // Remaining nodes of the last partial word
+  if (num_nodes % 64)
+    prune_candidates_scalar(degree + num_full_words * 64, threshold + num_full_words * 64,
+			    num_nodes % 64, mask + num_full_words);
+}
+
+
+/*-------------------------------------------------------------------------------
+ * AVX-512 version: compares 16 nodes per instruction into a mask register
+-------------------------------------------------------------------------------*/
+
+
+__attribute__((target("avx512f")))
+inline void prune_candidates_avx512(const int *degree, const int *threshold, long num_nodes, uint64_t *mask)
+{
+  long num_full_words = num_nodes / 64;
+  __m512i zero = _mm512_setzero_si512();
+
+  for (long w = 0; w < num_full_words; ++w) {
+
+    uint64_t word = 0;
+
+    for (int j = 0; j < 4; ++j) {
+      long i = w * 64 + j * 16;
+      __m512i deg = _mm512_loadu_si512((const void *)(degree + i));
+      __m512i thr = _mm512_loadu_si512((const void *)(threshold + i));
+
+      __mmask16 hit = _mm512_mask_cmpgt_epi32_mask(_mm512_cmpgt_epi32_mask(deg, zero), thr, deg);
+      word |= uint64_t(hit) << (j * 16);
+    }
+
+    mask[w] = word;
+  }
+
+  if (num_nodes % 64)
+    prune_candidates_scalar(degree + num_full_words * 64, threshold + num_full_words * 64,
+			    num_nodes % 64, mask + num_full_words);
+}
+
+
+/*-------------------------------------------------------------------------------
+ * AVX2 and AVX-512 versions for a threshold shared by all nodes
+-------------------------------------------------------------------------------*/
+
+
+__attribute__((target("avx2")))
+inline void prune_candidates_uniform_avx2(const int *degree, int threshold, long num_nodes, uint64_t *mask)
+{
+  long num_full_words = num_nodes / 64;
+  __m256i zero = _mm256_setzero_si256();
+  __m256i thr = _mm256_set1_epi32(threshold);
+
+  for (long w = 0; w < num_full_words; ++w) {
+
+    uint64_t word = 0;
+
+    for (int j = 0; j < 8; ++j) {
+      __m256i deg = _mm256_loadu_si256((const __m256i *)(degree + w * 64 + j * 8));
+      __m256i hit = _mm256_and_si256(_mm256_cmpgt_epi32(deg, zero), _mm256_cmpgt_epi32(thr, deg));
+      word |= uint64_t(_mm256_movemask_ps(_mm256_castsi256_ps(hit))) << (j * 8);
+    }
+
+    mask[w] = word;
+  }
+
+  if (num_nodes % 64)
+    prune_candidates_uniform_scalar(degree + num_full_words * 64, threshold, num_nodes % 64, mask + num_full_words);
+}
+
+
+__attribute__((target("avx512f")))
+inline void prune_candidates_uniform_avx512(const int *degree, int threshold, long num_nodes, uint64_t *mask)
+{
+  long num_full_words = num_nodes / 64;
+  __m512i zero = _mm512_setzero_si512();
+  __m512i thr = _mm512_set1_epi32(threshold);
+
+  for (long w = 0; w < num_full_words; ++w) {
+
+    uint64_t word = 0;
+
+    for (int j = 0; j < 4; ++j) {
+      __m512i deg = _mm512_loadu_si512((const void *)(degree + w * 64 + j * 16));
+      __mmask16 hit = _mm512_mask_cmpgt_epi32_mask(_mm512_cmpgt_epi32_mask(deg, zero), thr, deg);
+      word |= uint64_t(hit) << (j * 16);
+    }
+
+    mask[w] = word;
+  }
+
+  if (num_nodes % 64)
+    prune_candidates_uniform_scalar(degree + num_full_words * 64, threshold, num_nodes % 64, mask + num_full_words);
+}
+
+#endif
+
+
+/*-------------------------------------------------------------------------------
+ * @Returns the fastest kernel supported by the cpu the program runs on
+ * The choice is made once and reused by later calls
+-------------------------------------------------------------------------------*/
+
+
+inline prune_candidate_kernel select_prune_candidate_kernel()
+{
+  static prune_candidate_kernel kernel = 0;
+
+  if (kernel) return kernel;
+
+  kernel = prune_candidates_scalar;
+
+#ifdef NET_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f"))
+    kernel = prune_candidates_avx512;
+  else if (__builtin_cpu_supports("avx2"))
+    kernel = prune_candidates_avx2;
+#endif
+
+  return kernel;
+}
+
+
+inline prune_candidate_uniform_kernel select_prune_candidate_uniform_kernel()
+{
+  static prune_candidate_uniform_kernel kernel = 0;
+
+  if (kernel) return kernel;
+
+  kernel = prune_candidates_uniform_scalar;
+
+#ifdef NET_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f"))
+    kernel = prune_candidates_uniform_avx512;
+  else if (__builtin_cpu_supports("avx2"))
+    kernel = prune_candidates_uniform_avx2;
+#endif
+
+  return kernel;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param arrays of live degree and local threshold of every node
+ * @param number of nodes
+ * @param vector to store the bitmask of prunable nodes, resized to fit
+ * @return number of prunable nodes
+-------------------------------------------------------------------------------*/
+
+
+inline long find_prune_candidates(const int *degree, const int *threshold, long num_nodes, vector<uint64_t> &mask)
+{
+  mask.resize((num_nodes + 63) / 64);
+  select_prune_candidate_kernel()(degree, threshold, num_nodes, mask.data());
+
+  long num_candidates = 0;
+  for (size_t w = 0; w < mask.size(); ++w)
+    num_candidates += __builtin_popcountll(mask[w]);
+
+  return num_candidates;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param array of live degree of every node
+ * @param threshold shared by all nodes
+ * @param number of nodes
+ * @param vector to store the bitmask of prunable nodes, resized to fit
+-------------------------------------------------------------------------------*/
+
+
+inline void find_prune_candidates_uniform(const int *degree, int threshold, long num_nodes, vector<uint64_t> &mask)
+{
+  mask.resize((num_nodes + 63) / 64);
+  select_prune_candidate_uniform_kernel()(degree, threshold, num_nodes, mask.data());
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param bitmask of prunable nodes
+ * @param vector to store the indices of prunable nodes in increasing order
+-------------------------------------------------------------------------------*/
+
+
+inline void prune_candidate_list(const vector<uint64_t> &mask, vector<int> &candidates)
+{
+  candidates.clear();
+
+  for (size_t w = 0; w < mask.size(); ++w) {
+    uint64_t word = mask[w];
+    while (word) {
+      candidates.push_back(int(w * 64) + __builtin_ctzll(word));
+      word &= word - 1;
+    }
+  }
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param arrays of live degree and local threshold of every node
+ * @param number of nodes
+ * Verification sweep after pruning
+ * @return number of nodes that still violate the kcore condition, zero if pruning is complete
+-------------------------------------------------------------------------------*/
+
+
+inline long count_prune_violations(const int *degree, const int *threshold, long num_nodes)
+{
+  vector<uint64_t> mask;
+  return find_prune_candidates(degree, threshold, num_nodes, mask);
+}
+
+
+#endif
@@ -0,0 +1,106 @@
+/*-------------------------------------------------------------------------------
+ * Survival probability of every node of one network over many attack realizations
+ * The count of a node is the number of realizations in which it ends up in the biggest
+ * kcore cluster, taken from the biggest cluster masks of bitpar_find_biggest_clusters
+ * (net_bitpar.hpp), one mask adds up to 64 realizations and no node lists are copied
+ * Threads add their masks to the same counts with atomic additions and no locks, the
+ * counts do not depend on the order of the additions
+ * 1. Counter of every node, added from masks
+ * 2. Binary output, one unsigned 32 bit count per node in the index of the built network
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+
+#ifndef NET_SURVIVAL_HPP
+#define NET_SURVIVAL_HPP
+
+
+/*-----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <string>
+
+#include <fstream>
+
+#include "flat_graph.hpp"
+
+/*-----------------------------------------------------------------------------*/
+
+
+class Survival_counter {
+
+protected:
+
+  // Number of realizations in which every node is in the biggest cluster
+  vector<uint32_t> count;
+
+public:
+
+  Survival_counter(int num_nodes = 0) : count(num_nodes, 0) {}
+
+
+  // All counts set to 0, for the next percolation probability
+  void clear() { count.assign(count.size(), 0); }
+
+
+  // Adds the biggest cluster masks of up to 64 realizations, may be called by many threads at once
+  void add(const vector<uint64_t> &in_biggest);
+
+
+  uint32_t get_count(int node_idx) { return count[node_idx]; }
+
+
+  // Writes the counts to a binary file
+  bool write(const string &file_name, Flat_graph &net);
+};
+
+
+//------------------------------Member function definitions----------------------
+
+
+/*-------------------------------------------------------------------------------
+ * @param biggest cluster mask of every node, bit l set if the node is in the biggest
+ * cluster of realization l
+ * Nodes outside every biggest cluster are skipped, so a collapsed network costs one
+ * read per node
+-------------------------------------------------------------------------------*/
+
+
+inline void Survival_counter::add(const vector<uint64_t> &in_biggest)
+{
+  uint32_t *first = count.data();
+
+  for (size_t i = 0; i < in_biggest.size(); ++i)
+    if (in_biggest[i])
+      __atomic_fetch_add(first + i, uint32_t(__builtin_popcountll(in_biggest[i])), __ATOMIC_RELAXED);
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param name of the output file
+ * @param graph snapshot the counts were made on
+ * The file holds one unsigned 32 bit count per node in the byte order of the machine,
+ * node i of the built network first, divided by the number of realizations it is the
+ * survival probability of the node
+ * @Returns true if the file was written
+-------------------------------------------------------------------------------*/
+
+
+inline bool Survival_counter::write(const string &file_name, Flat_graph &net)
+{
+  int num_nodes = count.size();
+
+  vector<uint32_t> built_order(num_nodes);
+  for (int i = 0; i < num_nodes; ++i) built_order[i] = count[net.get_label(i)];
+
+  ofstream output_file(file_name.c_str(), ios::binary);
+  output_file.write((const char *) built_order.data(), num_nodes * sizeof(uint32_t));
+
+  return bool(output_file);
+}
+
+
+#endif
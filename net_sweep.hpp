@@ -0,0 +1,108 @@
+/*-------------------------------------------------------------------------------
+ * Newman-Ziff sweep for ordinary percolation (all kcore thresholds <= 1)
+ * No node is ever pruned, so the network at percolation probability p is the
+ * network of the first p*N nodes of one random order
+ * 1. Random order of all nodes
+ * 2. Nodes are added one by one and joined with union-find, the biggest cluster after
+ *    every addition gives the whole GC vs p curve in one pass
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+
+#ifndef NET_SWEEP_HPP
+#define NET_SWEEP_HPP
+
+
+/*-----------------------------------------------------------------------------*/
+
+#include <vector>
+
+#include "flat_graph.hpp"
+
+#include "net_cores.hpp"
+
+/*-----------------------------------------------------------------------------*/
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param vector to store all nodes in random order
+ * Fisher-Yates shuffle in the index of the built network, mapped to the snapshot
+-------------------------------------------------------------------------------*/
+
+
+inline void random_node_order(Flat_graph &net, vector<int> &order)
+{
+  int num_nodes = net.get_num_vertices();
+
+  order.resize(num_nodes);
+  for (int i = 0; i < num_nodes; ++i) order[i] = i;
+
+  for (int i = num_nodes - 1; i > 0; --i) {
+    int j = int(srand() * (i + 1));
+    swap(order[i], order[j]);
+  }
+
+  for (int i = 0; i < num_nodes; ++i) order[i] = net.get_label(order[i]);
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param graph snapshot
+ * @param order in which nodes are added
+ * @param vector to store the biggest cluster size with n nodes present, n = 0 .. N
+ * Nodes not yet added count as clusters of their own, as in find_biggest_cluster
+-------------------------------------------------------------------------------*/
+
+
+inline void occupation_sweep(Flat_graph &net, const vector<int> &order, vector<long> &biggest_size)
+{
+  int num_nodes = net.get_num_vertices();
+
+  vector<int> parent(num_nodes), cluster_size(num_nodes, 1);
+  for (int i = 0; i < num_nodes; ++i) parent[i] = i;
+
+  vector<char> present(num_nodes, 0);
+
+  biggest_size.assign(num_nodes + 1, 1);
+  long biggest = 1;
+
+  Flat_graph::node_neighbor_iterator it;
+
+  for (int n = 0; n < num_nodes; ++n) {
+
+    int v = order[n];
+    present[v] = 1;
+
+    for (it = net.vertex_neighbor_begin(v); it != net.vertex_neighbor_end(v); ++it) {
+      if (!present[*it]) continue;
+
+      int root_v = find_root(parent, v), root_u = find_root(parent, *it);
+      if (root_v == root_u) continue;
+
+      // Union by size
+      if (cluster_size[root_v] < cluster_size[root_u]) swap(root_v, root_u);
+      parent[root_u] = root_v;
+      cluster_size[root_v] += cluster_size[root_u];
+      if (cluster_size[root_v] > biggest) biggest = cluster_size[root_v];
+    }
+
+    biggest_size[n + 1] = biggest;
+  }
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param percolation probability
+ * @param number of nodes
+ * @Returns number of nodes present after initial_random_attack with the same probability
+-------------------------------------------------------------------------------*/
+
+
+inline int num_present_nodes(double p, int num_nodes)
+{
+  return num_nodes - int((1. - p) * num_nodes);
+}
+
+
+#endif
@@ -0,0 +1,264 @@
+/*-------------------------------------------------------------------------------
+ * Generating function theory of heterogeneous kcore percolation on a network with
+ * poissonian degree distribution (lt_ER_algo), the limit of an infinite network
+ * A node is kept with percolation probability p and has threshold1 with probability r,
+ * threshold2 otherwise (set_init_threshold_frac), with f_k the fraction of threshold k
+ *   X: probability that the node at the end of a random link survives the pruning,
+ *      given that the node at the start survives
+ *   Y: probability that it survives and leads to the infinite cluster
+ *   X  = p sum_k f_k  P[Poi(cX) >= k-1]
+ *   Y  = p sum_k f_k (P[Poi(cX) >= k-1] - exp(-cY) P[Poi(c(X-Y)) >= k-1])
+ *   GC = p sum_k f_k (P[Poi(cX) >= max(k,1)] - exp(-cY) P[Poi(c(X-Y)) >= max(k,1)])
+ * with c the average degree, of every equation the largest solution is taken
+ * 1. Giant component fraction for a percolation probability
+ * 2. Percolation threshold p_c, where the giant component appears
+ * 3. Grid of percolation probabilities, fine around p_c and coarse elsewhere
+ * @Author: Nagendra Panduranga
+-------------------------------------------------------------------------------*/
+
+
+#ifndef NET_THEORY_HPP
+#define NET_THEORY_HPP
+
+
+/*-----------------------------------------------------------------------------*/
+
+#include <vector>
+
+#include <algorithm>
+
+#include <functional>
+
+#include <cmath>
+
+/*-----------------------------------------------------------------------------*/
+
+
+/*-------------------------------------------------------------------------------
+ * @param mean of the poissonian distribution
+ * @param smallest value
+ * @Returns probability that a poissonian number is at least the smallest value
+-------------------------------------------------------------------------------*/
+
+
+inline double poisson_at_least(double mean, int smallest)
+{
+  if (smallest <= 0) return 1.0;
+
+  double term = exp(-mean), below = 0.0;
+  for (int j = 0; j < smallest; ++j) {
+    below += term;
+    term *= mean / (j + 1);
+  }
+
+  return below < 1.0 ? 1.0 - below : 0.0;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * Solution of the theory for a network and its thresholds
+-------------------------------------------------------------------------------*/
+
+
+class Kcore_theory {
+
+protected:
+
+  double avg_degree;
+  int threshold[2];
+  double prob_thresh[2];
+
+  double survive_sum(double p, double x, int shift);
+  double infinite_sum(double p, double x, double y, int shift, bool giant);
+
+  double largest_root(const function<double(double)> &excess, double high);
+
+public:
+
+  Kcore_theory(double avg_degree_inp, int threshold1, double prob_thresh1, int threshold2);
+
+  void solve(double p, double &x, double &y);
+
+  double giant_component(double p);
+
+  double critical_prob();
+
+  void prob_grid(double p_high, double p_low, double delta_coarse, double delta_fine, double width,
+		 vector<double> &probs);
+};
+
+
+//------------------------------Member function definitions----------------------
+
+
+/*-------------------------------------------------------------------------------
+ * @param average degree of the network
+ * @params threshold values and the probability of the first one
+-------------------------------------------------------------------------------*/
+
+
+inline Kcore_theory::Kcore_theory(double avg_degree_inp, int threshold1, double prob_thresh1, int threshold2)
+  : avg_degree(avg_degree_inp)
+{
+  threshold[0] = threshold1;
+  threshold[1] = threshold2;
+  prob_thresh[0] = prob_thresh1;
+  prob_thresh[1] = 1.0 - prob_thresh1;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @Returns p sum_k f_k P[Poi(cx) >= k-shift], right side of the equation of X
+-------------------------------------------------------------------------------*/
+
+
+inline double Kcore_theory::survive_sum(double p, double x, int shift)
+{
+  double sum = 0.0;
+  for (int t = 0; t < 2; ++t)
+    sum += prob_thresh[t] * poisson_at_least(avg_degree * x, threshold[t] - shift);
+
+  return p * sum;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @Returns right side of the equation of Y (k-1 surviving neighbors) or of GC (k and
+ * at least 1), a node is counted if it survives with at least one infinite branch
+-------------------------------------------------------------------------------*/
+
+
+inline double Kcore_theory::infinite_sum(double p, double x, double y, int shift, bool giant)
+{
+  double sum = 0.0;
+  for (int t = 0; t < 2; ++t) {
+    int smallest = threshold[t] - shift;
+    if (giant) smallest = max(smallest, 1);
+    sum += prob_thresh[t] * (poisson_at_least(avg_degree * x, smallest)
+			     - exp(-avg_degree * y) * poisson_at_least(avg_degree * (x - y), smallest));
+  }
+
+  return p * sum;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param excess f(z) - z of a fixed point equation z = f(z), f increasing
+ * @param upper end of the interval [0, high], excess(high) <= 0
+ * @Returns largest root in the interval, 0 if none above 0 is found
+ * The interval is scanned downwards, linearly and then in decades towards 0 where a
+ * continuous transition starts, the first sign change is bisected
+ * The linear scan ends 3 decades below high (high / num_linear), the decades add 6 more,
+ * so the scan stops 9 decades below high, closer to 0 the excess is rounding noise
+-------------------------------------------------------------------------------*/
+
+
+inline double Kcore_theory::largest_root(const function<double(double)> &excess, double high)
+{
+  if (high <= 0.0) return 0.0;
+
+  const int num_linear = 1000;
+  const int num_decades = 6;
+
+  double above = high, below = 0.0;
+  bool found = false;
+
+  for (int j = 1; j <= num_linear + 10 * num_decades && !found; ++j) {
+    double z = j < num_linear ? high * (1.0 - double(j) / num_linear)
+      : high / num_linear * pow(10.0, -double(j - num_linear) / 10.0);
+    if (excess(z) >= 0.0) {
+      below = z;
+      found = true;
+    }
+    else above = z;
+  }
+
+  if (!found) return 0.0;
+
+  for (int b = 0; b < 60; ++b) {
+    double mid = 0.5 * (above + below);
+    if (excess(mid) >= 0.0) below = mid;
+    else above = mid;
+  }
+
+  return below;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param percolation probability
+ * @param X, probability that a link leads to a surviving node
+ * @param Y, probability that a link leads to the infinite cluster
+-------------------------------------------------------------------------------*/
+
+
+inline void Kcore_theory::solve(double p, double &x, double &y)
+{
+  x = largest_root([&](double z) { return survive_sum(p, z, 1) - z; }, 1.0);
+  y = largest_root([&](double z) { return infinite_sum(p, x, z, 1, false) - z; }, x);
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param percolation probability
+ * @Returns fraction of nodes in the giant component
+-------------------------------------------------------------------------------*/
+
+
+inline double Kcore_theory::giant_component(double p)
+{
+  double x, y;
+  solve(p, x, y);
+
+  return y > 0.0 ? infinite_sum(p, x, y, 0, true) : 0.0;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @Returns smallest percolation probability with a giant component, found by bisection
+ * as the giant component grows with p, 1 if there is none even at p = 1
+-------------------------------------------------------------------------------*/
+
+
+inline double Kcore_theory::critical_prob()
+{
+  double low = 0.0, high = 1.0;
+  if (giant_component(high) <= 0.0) return 1.0;
+
+  for (int b = 0; b < 50; ++b) {
+    double mid = 0.5 * (low + high);
+    if (giant_component(mid) > 0.0) high = mid;
+    else low = mid;
+  }
+
+  return high;
+}
+
+
+/*-------------------------------------------------------------------------------
+ * @param largest and smallest percolation probability
+ * @param step far from the transition
+ * @param step around the transition
+ * @param half width of the interval around p_c with the fine step
+ * @param vector to store the percolation probabilities, decreasing
+ * Coarse steps down from p_high, fine steps in [p_c - width, p_c + width]
+-------------------------------------------------------------------------------*/
+
+
+inline void Kcore_theory::prob_grid(double p_high, double p_low, double delta_coarse, double delta_fine,
+				    double width, vector<double> &probs)
+{
+  double p_c = critical_prob();
+  probs.clear();
+
+  for (double p = p_high; p >= p_low; p -= delta_coarse)
+    if (fabs(p - p_c) > width) probs.push_back(p);
+
+  for (double p = min(p_c + width, p_high); p >= max(p_c - width, p_low); p -= delta_fine)
+    probs.push_back(p);
+
+  sort(probs.begin(), probs.end(), greater<double>());
+}
+
+
+#endif
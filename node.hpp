@@ -1,5 +1,5 @@
 /*-------------------------------------------------------------------------------
- * Contains Node class 
+ * Contains Node class template, Node uses the default allocator
  * Contains Node member function definitions 
  * @Author: Nagendra Panduranga
 -------------------------------------------------------------------------------*/
@@ -14,21 +14,25 @@
 
 #include <list>
 
+#include <memory>
+
 #include <iostream>
 
 /*-----------------------------------------------------------------------------*/
 
 
-class Node {
+// Alloc allocates the list elements, see net_arena.hpp for an arena allocator
+template <class Alloc = allocator<int> >
+class Node_t {
 
 protected:
 
   // List of indices of nodes linked to the current node
-  list<int> neighbors;
+  list<int, Alloc> neighbors;
 
 
   // List of dependent node on the current node
-  list<int> dependants;
+  list<int, Alloc> dependants;
 
   
   // Integer value if the node is dependent on another node 
@@ -72,26 +76,47 @@ public:
 
   
   // iterator definition
-  typedef list<int>::iterator neighbor_iterator;
+  typedef typename list<int, Alloc>::iterator neighbor_iterator;
   neighbor_iterator neighbor_begin() { return neighbors.begin(); }
   neighbor_iterator neighbor_end() { return neighbors.end(); }
 
   
   // constructor
-  Node() {
+  Node_t(const Alloc &alloc = Alloc()) : neighbors(alloc), dependants(alloc) {
     
     protect_status=0;
     dependence = 0; 
   }
+
+
+  // copy constructor placing the lists with the input allocator
+  template <class Other_alloc>
+  Node_t(const Node_t<Other_alloc> &other, const Alloc &alloc)
+    : neighbors(other.neighbors.begin(), other.neighbors.end(), alloc),
+      dependants(other.dependants.begin(), other.dependants.end(), alloc) {
+
+    dependence = other.dependence;
+    protect_status = other.protect_status;
+    threshold = other.threshold;
+  }
+
+
+  // nodes with other allocators are copied from
+  template <class Other_alloc> friend class Node_t;
 };
 
+
+// Node with lists on the heap
+typedef Node_t<> Node;
+
 //------------------------------Member function definitions----------------------
 /*-------------------------------------------------------------------------------
  * Returns the number of neighbors of the node
 -------------------------------------------------------------------------------*/
 
 
-int Node::get_degree()
+template <class Alloc>
+int Node_t<Alloc>::get_degree()
 {
   return neighbors.size();
 }
@@ -102,7 +127,8 @@ int Node::get_degree()
 -------------------------------------------------------------------------------*/
 
 
-void Node::add_a_neighbor(int other_node_index)
+template <class Alloc>
+void Node_t<Alloc>::add_a_neighbor(int other_node_index)
 {
   neighbors.push_back(other_node_index);
 }
@@ -114,7 +140,8 @@ void Node::add_a_neighbor(int other_node_index)
 -------------------------------------------------------------------------------*/
 
 
-void Node::rm_a_neighbor(int node_index)
+template <class Alloc>
+void Node_t<Alloc>::rm_a_neighbor(int node_index)
 {
 
   neighbor_iterator it;
@@ -142,7 +169,8 @@ void Node::rm_a_neighbor(int node_index)
 -------------------------------------------------------------------------------*/
 
 
-void Node::rm_all_neighbors()
+template <class Alloc>
+void Node_t<Alloc>::rm_all_neighbors()
 {
   neighbors.clear();
   return;
@@ -155,7 +183,8 @@ void Node::rm_all_neighbors()
 -------------------------------------------------------------------------------*/
 
 
-void Node::add_a_dependant(int node_index)
+template <class Alloc>
+void Node_t<Alloc>::add_a_dependant(int node_index)
 {
   dependants.push_back(node_index);
 }
@@ -167,7 +196,8 @@ void Node::add_a_dependant(int node_index)
 -------------------------------------------------------------------------------*/
 
 
-void Node::rm_a_dependant(int node_index){
+template <class Alloc>
+void Node_t<Alloc>::rm_a_dependant(int node_index){
   neighbor_iterator it;
   for(it=dependants.begin();it!=dependants.end();++it){
     if(*it==node_index){
@@ -189,7 +219,8 @@ void Node::rm_a_dependant(int node_index){
 -------------------------------------------------------------------------------*/
 
 
-void Node::rm_all_dependants()
+template <class Alloc>
+void Node_t<Alloc>::rm_all_dependants()
 {
   dependants.clear();
 } 
@@ -201,7 +232,8 @@ void Node::rm_all_dependants()
 -------------------------------------------------------------------------------*/
 
 
-void Node::protect_node()
+template <class Alloc>
+void Node_t<Alloc>::protect_node()
 {
   protect_status=1;
 }
@@ -213,7 +245,8 @@ void Node::protect_node()
 -------------------------------------------------------------------------------*/
 
 
-void Node::unprotect_node()
+template <class Alloc>
+void Node_t<Alloc>::unprotect_node()
 {
   protect_status=0;
 }
@@ -225,7 +258,8 @@ void Node::unprotect_node()
 -------------------------------------------------------------------------------*/
 
 
-bool Node::protect_check()
+template <class Alloc>
+bool Node_t<Alloc>::protect_check()
 {
   if(protect_status) return true;
   else return false;
@@ -237,7 +271,8 @@ bool Node::protect_check()
 -------------------------------------------------------------------------------*/
 
 
-void Node::set_dependence(int dependence_value){
+template <class Alloc>
+void Node_t<Alloc>::set_dependence(int dependence_value){
   dependence = dependence_value;
 }
 
@@ -247,7 +282,8 @@ void Node::set_dependence(int dependence_value){
 -------------------------------------------------------------------------------*/
 
 
-int Node::get_dependence()
+template <class Alloc>
+int Node_t<Alloc>::get_dependence()
 {
   return dependence;
 }
@@ -258,7 +294,8 @@ int Node::get_dependence()
 -------------------------------------------------------------------------------*/
 
 
-void Node::set_threshold(int threshold_inp)
+template <class Alloc>
+void Node_t<Alloc>::set_threshold(int threshold_inp)
 {
   threshold = threshold_inp;
 }
@@ -269,7 +306,8 @@ void Node::set_threshold(int threshold_inp)
 -------------------------------------------------------------------------------*/
 
 
-int Node::get_threshold()
+template <class Alloc>
+int Node_t<Alloc>::get_threshold()
 {
   return threshold;
 }
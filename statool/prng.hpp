@@ -0,0 +1,56 @@
+/* random number streams using the 'mzran' algorithm of srand.hpp,
+   every Rng_stream keeps its own state, so threads can draw random
+   numbers without sharing a generator.
+   Rng_stream(seed, stream) gives independent streams for the same seed,
+   next() generates a random number in the range [0,1), next_bits() the
+   same step as 32 bits in the same order. */
+
+#ifndef PRNG_HPP
+#define PRNG_HPP
+#include <stdint.h>
+#include <stdlib.h>
+using namespace std;
+
+class Rng_stream {
+
+protected:
+
+  int ir, jr, kr;
+  unsigned nr;
+
+  // splitmix64 step, spreads seed and stream index over the state
+  static uint64_t mix(uint64_t &x) {
+    uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+
+public:
+
+  double next() {
+    int m = ir - kr;
+    if (m < 0) m = m + 2147483579;
+    ir = jr; jr = kr; kr = m;
+    nr = 69069u * nr + 1013904243u;
+    return 0.5e0 + int(unsigned(m) + nr) * 0.23283064e-9;
+  }
+
+  uint32_t next_bits() {
+    int m = ir - kr;
+    if (m < 0) m = m + 2147483579;
+    ir = jr; jr = kr; kr = m;
+    nr = 69069u * nr + 1013904243u;
+    return (unsigned(m) + nr) ^ 0x80000000u;
+  }
+
+  Rng_stream(uint64_t seed = 0, uint64_t stream = 0) {
+    uint64_t x = seed ^ (stream * 0xd1b54a32d192ed03ULL);
+    ir = int(mix(x) % 2147483000) + 1;
+    jr = int(mix(x) % 2147483000) + 1;
+    kr = int(mix(x) % 2147483000) + 1;
+    nr = unsigned(mix(x));
+  }
+};
+
+#endif